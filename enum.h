@@ -8,10 +8,20 @@
 
 
 
-#include <cstddef>
-#include <cstring>
-#include <iosfwd>
-#include <stdexcept>
+// The better_enums module, extra/better-enums/better_enums.cppm, includes the
+// standard headers before enum.h, and defines BETTER_ENUMS_MODULE_INTERFACE.
+// Programs that import it define BETTER_ENUMS_MODULE_IMPORTED before including
+// enum.h, which then only defines the macros, and includes the headers that
+// their expansions use.
+#ifndef BETTER_ENUMS_MODULE_INTERFACE
+#   include <cstddef>
+#   include <iosfwd>
+#   ifndef BETTER_ENUMS_MODULE_IMPORTED
+#       include <climits>
+#       include <cstring>
+#       include <stdexcept>
+#   endif
+#endif
 
 
 // in-line, non-#pragma warning handling
@@ -122,12 +132,122 @@
 #   define BETTER_ENUMS_NULLPTR        NULL
 #endif
 
+// C++14 relaxed constexpr allows loops and assignments in constexpr functions.
+// When it is available, Better Enums uses it to build lookup tables in a single
+// pass.
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+#   ifdef __cpp_constexpr
+#       if __cpp_constexpr >= 201304L
+#           define BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+#       endif
+#   endif
+#endif
+
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+#   define BETTER_ENUMS_RELAXED_CONSTEXPR_ constexpr
+#else
+#   define BETTER_ENUMS_RELAXED_CONSTEXPR_
+#endif
+
+// Whether a function can tell that it is being evaluated at compile time. Where
+// it can, name lookup scans the names in constant expressions, and uses a hash
+// table at run time, which is built by the first lookup, so that no enum pays
+// for building the table during compilation. Lookups evaluated at compile time
+// are also not reported to BETTER_ENUMS_CONVERSION_HOOK, so that they remain
+// constant expressions.
+#if defined(__has_builtin)
+#   if __has_builtin(__builtin_is_constant_evaluated)
+#       define BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
+#   endif
+#endif
+#ifndef BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
+#   if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#       define BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
+#   elif defined(_MSC_VER) && _MSC_VER >= 1925
+#       define BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
+#   endif
+#endif
+#ifdef BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
+#   define BETTER_ENUMS_IS_CONSTANT_EVALUATED()                                \
+        __builtin_is_constant_evaluated()
+#else
+#   define BETTER_ENUMS_IS_CONSTANT_EVALUATED() false
+#endif
+
 #ifndef BETTER_ENUMS_NO_EXCEPTIONS
 #   define BETTER_ENUMS_IF_EXCEPTIONS(x) x
 #else
 #   define BETTER_ENUMS_IF_EXCEPTIONS(x)
 #endif
 
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+#   define BETTER_ENUMS_IF_CONSTEXPR(x) x
+#else
+#   define BETTER_ENUMS_IF_CONSTEXPR(x)
+#endif
+
+#ifndef BETTER_ENUMS_NO_STRING_VIEW
+#   ifdef _MSVC_LANG
+#       if _MSVC_LANG >= 201703L
+#           define BETTER_ENUMS_HAVE_STRING_VIEW
+#       endif
+#   elif __cplusplus >= 201703L
+#       define BETTER_ENUMS_HAVE_STRING_VIEW
+#   endif
+#endif
+
+#if defined(BETTER_ENUMS_HAVE_CONSTEXPR) &&                                   \
+    !defined(BETTER_ENUMS_MODULE_INTERFACE) &&                                 \
+    !defined(BETTER_ENUMS_MODULE_IMPORTED)
+#   include <type_traits>
+#endif
+
+#ifdef BETTER_ENUMS_HAVE_STRING_VIEW
+#   ifndef BETTER_ENUMS_MODULE_INTERFACE
+#       include <string_view>
+#   endif
+#   define BETTER_ENUMS_IF_STRING_VIEW(x) x
+#else
+#   define BETTER_ENUMS_IF_STRING_VIEW(x)
+#endif
+
+// C++17 template <auto> parameters allow make_static_map to take the mapping
+// function as its only template argument.
+#ifdef __cpp_nontype_template_parameter_auto
+#   if __cpp_nontype_template_parameter_auto >= 201606L
+#       define BETTER_ENUMS_HAVE_AUTO_TEMPLATE_PARAMETER
+#   endif
+#endif
+
+// With BETTER_ENUMS_INLINE_DATA and C++17 inline variables, the tables of each
+// enum are inline variables, which have external linkage, so there is one copy
+// of them in the program, rather than one in each translation unit. There is
+// then also no initializer per translation unit, since initialization happens
+// on first use anyway.
+#ifdef BETTER_ENUMS_INLINE_DATA
+#   ifdef __cpp_inline_variables
+#       if __cpp_inline_variables >= 201606L
+#           define BETTER_ENUMS_HAVE_INLINE_DATA
+#       endif
+#   endif
+#endif
+
+#ifdef BETTER_ENUMS_HAVE_INLINE_DATA
+#   define BETTER_ENUMS_DATA_ inline
+#else
+#   define BETTER_ENUMS_DATA_
+#endif
+
+// A few helpers and constants in namespace better_enums have internal linkage,
+// except in the module interface, which can only export entities with external
+// linkage. The module requires C++20, so they are inline variables and
+// functions there.
+#ifdef BETTER_ENUMS_MODULE_INTERFACE
+#   define BETTER_ENUMS_STATIC_ inline
+#else
+#   define BETTER_ENUMS_STATIC_ static
+#endif
+
 #ifdef __GNUC__
 #   define BETTER_ENUMS_UNUSED __attribute__((__unused__))
 #else
@@ -155,133 +275,245 @@
 
 #define BETTER_ENUMS_ID(x) x
 
-#define BETTER_ENUMS_M1(m, d, x) m(d,0,x)
-#define BETTER_ENUMS_M2(m,d,x,...) m(d,1,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M1(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M3(m,d,x,...) m(d,2,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M2(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M4(m,d,x,...) m(d,3,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M3(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M5(m,d,x,...) m(d,4,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M4(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M6(m,d,x,...) m(d,5,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M5(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M7(m,d,x,...) m(d,6,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M6(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M8(m,d,x,...) m(d,7,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M7(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M9(m,d,x,...) m(d,8,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M8(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M10(m,d,x,...) m(d,9,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M9(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M11(m,d,x,...) m(d,10,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M10(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M12(m,d,x,...) m(d,11,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M11(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M13(m,d,x,...) m(d,12,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M12(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M14(m,d,x,...) m(d,13,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M13(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M15(m,d,x,...) m(d,14,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M14(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M16(m,d,x,...) m(d,15,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M15(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M17(m,d,x,...) m(d,16,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M18(m,d,x,...) m(d,17,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M17(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M19(m,d,x,...) m(d,18,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M18(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M20(m,d,x,...) m(d,19,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M19(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M21(m,d,x,...) m(d,20,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M20(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M22(m,d,x,...) m(d,21,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M21(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M23(m,d,x,...) m(d,22,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M22(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M24(m,d,x,...) m(d,23,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M23(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M25(m,d,x,...) m(d,24,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M24(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M26(m,d,x,...) m(d,25,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M25(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M27(m,d,x,...) m(d,26,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M26(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M28(m,d,x,...) m(d,27,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M27(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M29(m,d,x,...) m(d,28,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M28(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M30(m,d,x,...) m(d,29,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M29(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M31(m,d,x,...) m(d,30,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M30(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M32(m,d,x,...) m(d,31,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M31(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M33(m,d,x,...) m(d,32,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M32(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M34(m,d,x,...) m(d,33,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M33(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M35(m,d,x,...) m(d,34,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M34(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M36(m,d,x,...) m(d,35,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M35(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M37(m,d,x,...) m(d,36,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M36(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M38(m,d,x,...) m(d,37,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M37(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M39(m,d,x,...) m(d,38,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M38(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M40(m,d,x,...) m(d,39,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M39(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M41(m,d,x,...) m(d,40,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M40(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M42(m,d,x,...) m(d,41,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M41(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M43(m,d,x,...) m(d,42,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M42(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M44(m,d,x,...) m(d,43,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M43(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M45(m,d,x,...) m(d,44,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M44(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M46(m,d,x,...) m(d,45,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M45(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M47(m,d,x,...) m(d,46,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M46(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M48(m,d,x,...) m(d,47,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M47(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M49(m,d,x,...) m(d,48,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M48(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M50(m,d,x,...) m(d,49,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M49(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M51(m,d,x,...) m(d,50,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M50(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M52(m,d,x,...) m(d,51,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M51(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M53(m,d,x,...) m(d,52,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M52(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M54(m,d,x,...) m(d,53,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M53(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M55(m,d,x,...) m(d,54,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M54(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M56(m,d,x,...) m(d,55,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M55(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M57(m,d,x,...) m(d,56,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M56(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M58(m,d,x,...) m(d,57,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M57(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M59(m,d,x,...) m(d,58,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M58(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M60(m,d,x,...) m(d,59,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M59(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M61(m,d,x,...) m(d,60,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M60(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M62(m,d,x,...) m(d,61,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M61(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M63(m,d,x,...) m(d,62,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M62(m,d,__VA_ARGS__))
-#define BETTER_ENUMS_M64(m,d,x,...) m(d,63,x) \
-    BETTER_ENUMS_ID(BETTER_ENUMS_M63(m,d,__VA_ARGS__))
+#define BETTER_ENUMS_M1(m, d, _1) m(d, 0, _1)
+#define BETTER_ENUMS_M2(m, d, _1, _2) m(d, 1, _1) m(d, 0, _2)
+#define BETTER_ENUMS_M3(m, d, _1, _2, _3) m(d, 2, _1) m(d, 1, _2) m(d, 0, _3)
+#define BETTER_ENUMS_M4(m, d, _1, _2, _3, _4) m(d, 3, _1) m(d, 2, _2)          \
+    m(d, 1, _3) m(d, 0, _4)
+#define BETTER_ENUMS_M5(m, d, _1, _2, _3, _4, _5) m(d, 4, _1) m(d, 3, _2)      \
+    m(d, 2, _3) m(d, 1, _4) m(d, 0, _5)
+#define BETTER_ENUMS_M6(m, d, _1, _2, _3, _4, _5, _6) m(d, 5, _1) m(d, 4, _2)  \
+    m(d, 3, _3) m(d, 2, _4) m(d, 1, _5) m(d, 0, _6)
+#define BETTER_ENUMS_M7(m, d, _1, _2, _3, _4, _5, _6, _7) m(d, 6, _1)          \
+    m(d, 5, _2) m(d, 4, _3) m(d, 3, _4) m(d, 2, _5) m(d, 1, _6) m(d, 0, _7)
+#define BETTER_ENUMS_M8(m, d, _1, _2, _3, _4, _5, _6, _7, _8) m(d, 7, _1)      \
+    m(d, 6, _2) m(d, 5, _3) m(d, 4, _4) m(d, 3, _5) m(d, 2, _6) m(d, 1, _7)    \
+    m(d, 0, _8)
+#define BETTER_ENUMS_M9(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9) m(d, 8, _1)  \
+    m(d, 7, _2) m(d, 6, _3) m(d, 5, _4) m(d, 4, _5) m(d, 3, _6) m(d, 2, _7)    \
+    m(d, 1, _8) m(d, 0, _9)
+#define BETTER_ENUMS_M10(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10)        \
+    m(d, 9, _1) m(d, 8, _2) m(d, 7, _3) m(d, 6, _4) m(d, 5, _5) m(d, 4, _6)    \
+    m(d, 3, _7) m(d, 2, _8) m(d, 1, _9) m(d, 0, _10)
+#define BETTER_ENUMS_M11(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11)   \
+    m(d, 10, _1) m(d, 9, _2) m(d, 8, _3) m(d, 7, _4) m(d, 6, _5) m(d, 5, _6)   \
+    m(d, 4, _7) m(d, 3, _8) m(d, 2, _9) m(d, 1, _10) m(d, 0, _11)
+#define BETTER_ENUMS_M12(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12) m(d, 11, _1) m(d, 10, _2) m(d, 9, _3) m(d, 8, _4) m(d, 7, _5)         \
+    m(d, 6, _6) m(d, 5, _7) m(d, 4, _8) m(d, 3, _9) m(d, 2, _10) m(d, 1, _11)  \
+    m(d, 0, _12)
+#define BETTER_ENUMS_M13(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13) m(d, 12, _1) m(d, 11, _2) m(d, 10, _3) m(d, 9, _4) m(d, 8, _5)   \
+    m(d, 7, _6) m(d, 6, _7) m(d, 5, _8) m(d, 4, _9) m(d, 3, _10) m(d, 2, _11)  \
+    m(d, 1, _12) m(d, 0, _13)
+#define BETTER_ENUMS_M14(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14) m(d, 13, _1) m(d, 12, _2) m(d, 11, _3) m(d, 10, _4)         \
+    m(d, 9, _5) m(d, 8, _6) m(d, 7, _7) m(d, 6, _8) m(d, 5, _9) m(d, 4, _10)   \
+    m(d, 3, _11) m(d, 2, _12) m(d, 1, _13) m(d, 0, _14)
+#define BETTER_ENUMS_M15(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15) m(d, 14, _1) m(d, 13, _2) m(d, 12, _3) m(d, 11, _4)    \
+    m(d, 10, _5) m(d, 9, _6) m(d, 8, _7) m(d, 7, _8) m(d, 6, _9) m(d, 5, _10)  \
+    m(d, 4, _11) m(d, 3, _12) m(d, 2, _13) m(d, 1, _14) m(d, 0, _15)
+#define BETTER_ENUMS_M16(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15, _16) m(d, 15, _1) m(d, 14, _2) m(d, 13, _3)            \
+    m(d, 12, _4) m(d, 11, _5) m(d, 10, _6) m(d, 9, _7) m(d, 8, _8) m(d, 7, _9) \
+    m(d, 6, _10) m(d, 5, _11) m(d, 4, _12) m(d, 3, _13) m(d, 2, _14)           \
+    m(d, 1, _15) m(d, 0, _16)
+#define BETTER_ENUMS_M17(m, d, _1, ...) m(d, 16, _1)                           \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M18(m, d, _1, _2, ...) m(d, 17, _1) m(d, 16, _2)          \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M19(m, d, _1, _2, _3, ...) m(d, 18, _1) m(d, 17, _2)      \
+    m(d, 16, _3) BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M20(m, d, _1, _2, _3, _4, ...) m(d, 19, _1) m(d, 18, _2)  \
+    m(d, 17, _3) m(d, 16, _4)                                                  \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M21(m, d, _1, _2, _3, _4, _5, ...) m(d, 20, _1)           \
+    m(d, 19, _2) m(d, 18, _3) m(d, 17, _4) m(d, 16, _5)                        \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M22(m, d, _1, _2, _3, _4, _5, _6, ...) m(d, 21, _1)       \
+    m(d, 20, _2) m(d, 19, _3) m(d, 18, _4) m(d, 17, _5) m(d, 16, _6)           \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M23(m, d, _1, _2, _3, _4, _5, _6, _7, ...) m(d, 22, _1)   \
+    m(d, 21, _2) m(d, 20, _3) m(d, 19, _4) m(d, 18, _5) m(d, 17, _6)           \
+    m(d, 16, _7) BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M24(m, d, _1, _2, _3, _4, _5, _6, _7, _8, ...)            \
+    m(d, 23, _1) m(d, 22, _2) m(d, 21, _3) m(d, 20, _4) m(d, 19, _5)           \
+    m(d, 18, _6) m(d, 17, _7) m(d, 16, _8)                                     \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M25(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, ...)        \
+    m(d, 24, _1) m(d, 23, _2) m(d, 22, _3) m(d, 21, _4) m(d, 20, _5)           \
+    m(d, 19, _6) m(d, 18, _7) m(d, 17, _8) m(d, 16, _9)                        \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M26(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, ...)   \
+    m(d, 25, _1) m(d, 24, _2) m(d, 23, _3) m(d, 22, _4) m(d, 21, _5)           \
+    m(d, 20, _6) m(d, 19, _7) m(d, 18, _8) m(d, 17, _9) m(d, 16, _10)          \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M27(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    ...) m(d, 26, _1) m(d, 25, _2) m(d, 24, _3) m(d, 23, _4) m(d, 22, _5)      \
+    m(d, 21, _6) m(d, 20, _7) m(d, 19, _8) m(d, 18, _9) m(d, 17, _10)          \
+    m(d, 16, _11) BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M28(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, ...) m(d, 27, _1) m(d, 26, _2) m(d, 25, _3) m(d, 24, _4) m(d, 23, _5) \
+    m(d, 22, _6) m(d, 21, _7) m(d, 20, _8) m(d, 19, _9) m(d, 18, _10)          \
+    m(d, 17, _11) m(d, 16, _12)                                                \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M29(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, ...) m(d, 28, _1) m(d, 27, _2) m(d, 26, _3) m(d, 25, _4)         \
+    m(d, 24, _5) m(d, 23, _6) m(d, 22, _7) m(d, 21, _8) m(d, 20, _9)           \
+    m(d, 19, _10) m(d, 18, _11) m(d, 17, _12) m(d, 16, _13)                    \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M30(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, ...) m(d, 29, _1) m(d, 28, _2) m(d, 27, _3) m(d, 26, _4)    \
+    m(d, 25, _5) m(d, 24, _6) m(d, 23, _7) m(d, 22, _8) m(d, 21, _9)           \
+    m(d, 20, _10) m(d, 19, _11) m(d, 18, _12) m(d, 17, _13) m(d, 16, _14)      \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M31(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15, ...) m(d, 30, _1) m(d, 29, _2) m(d, 28, _3)            \
+    m(d, 27, _4) m(d, 26, _5) m(d, 25, _6) m(d, 24, _7) m(d, 23, _8)           \
+    m(d, 22, _9) m(d, 21, _10) m(d, 20, _11) m(d, 19, _12) m(d, 18, _13)       \
+    m(d, 17, _14) m(d, 16, _15)                                                \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M32(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15, _16, ...) m(d, 31, _1) m(d, 30, _2) m(d, 29, _3)       \
+    m(d, 28, _4) m(d, 27, _5) m(d, 26, _6) m(d, 25, _7) m(d, 24, _8)           \
+    m(d, 23, _9) m(d, 22, _10) m(d, 21, _11) m(d, 20, _12) m(d, 19, _13)       \
+    m(d, 18, _14) m(d, 17, _15) m(d, 16, _16)                                  \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M33(m, d, _1, ...) m(d, 32, _1)                           \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M34(m, d, _1, _2, ...) m(d, 33, _1) m(d, 32, _2)          \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M35(m, d, _1, _2, _3, ...) m(d, 34, _1) m(d, 33, _2)      \
+    m(d, 32, _3) BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M36(m, d, _1, _2, _3, _4, ...) m(d, 35, _1) m(d, 34, _2)  \
+    m(d, 33, _3) m(d, 32, _4)                                                  \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M37(m, d, _1, _2, _3, _4, _5, ...) m(d, 36, _1)           \
+    m(d, 35, _2) m(d, 34, _3) m(d, 33, _4) m(d, 32, _5)                        \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M38(m, d, _1, _2, _3, _4, _5, _6, ...) m(d, 37, _1)       \
+    m(d, 36, _2) m(d, 35, _3) m(d, 34, _4) m(d, 33, _5) m(d, 32, _6)           \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M39(m, d, _1, _2, _3, _4, _5, _6, _7, ...) m(d, 38, _1)   \
+    m(d, 37, _2) m(d, 36, _3) m(d, 35, _4) m(d, 34, _5) m(d, 33, _6)           \
+    m(d, 32, _7) BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M40(m, d, _1, _2, _3, _4, _5, _6, _7, _8, ...)            \
+    m(d, 39, _1) m(d, 38, _2) m(d, 37, _3) m(d, 36, _4) m(d, 35, _5)           \
+    m(d, 34, _6) m(d, 33, _7) m(d, 32, _8)                                     \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M41(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, ...)        \
+    m(d, 40, _1) m(d, 39, _2) m(d, 38, _3) m(d, 37, _4) m(d, 36, _5)           \
+    m(d, 35, _6) m(d, 34, _7) m(d, 33, _8) m(d, 32, _9)                        \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M42(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, ...)   \
+    m(d, 41, _1) m(d, 40, _2) m(d, 39, _3) m(d, 38, _4) m(d, 37, _5)           \
+    m(d, 36, _6) m(d, 35, _7) m(d, 34, _8) m(d, 33, _9) m(d, 32, _10)          \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M43(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    ...) m(d, 42, _1) m(d, 41, _2) m(d, 40, _3) m(d, 39, _4) m(d, 38, _5)      \
+    m(d, 37, _6) m(d, 36, _7) m(d, 35, _8) m(d, 34, _9) m(d, 33, _10)          \
+    m(d, 32, _11) BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M44(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, ...) m(d, 43, _1) m(d, 42, _2) m(d, 41, _3) m(d, 40, _4) m(d, 39, _5) \
+    m(d, 38, _6) m(d, 37, _7) m(d, 36, _8) m(d, 35, _9) m(d, 34, _10)          \
+    m(d, 33, _11) m(d, 32, _12)                                                \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M45(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, ...) m(d, 44, _1) m(d, 43, _2) m(d, 42, _3) m(d, 41, _4)         \
+    m(d, 40, _5) m(d, 39, _6) m(d, 38, _7) m(d, 37, _8) m(d, 36, _9)           \
+    m(d, 35, _10) m(d, 34, _11) m(d, 33, _12) m(d, 32, _13)                    \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M46(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, ...) m(d, 45, _1) m(d, 44, _2) m(d, 43, _3) m(d, 42, _4)    \
+    m(d, 41, _5) m(d, 40, _6) m(d, 39, _7) m(d, 38, _8) m(d, 37, _9)           \
+    m(d, 36, _10) m(d, 35, _11) m(d, 34, _12) m(d, 33, _13) m(d, 32, _14)      \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M47(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15, ...) m(d, 46, _1) m(d, 45, _2) m(d, 44, _3)            \
+    m(d, 43, _4) m(d, 42, _5) m(d, 41, _6) m(d, 40, _7) m(d, 39, _8)           \
+    m(d, 38, _9) m(d, 37, _10) m(d, 36, _11) m(d, 35, _12) m(d, 34, _13)       \
+    m(d, 33, _14) m(d, 32, _15)                                                \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M48(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15, _16, ...) m(d, 47, _1) m(d, 46, _2) m(d, 45, _3)       \
+    m(d, 44, _4) m(d, 43, _5) m(d, 42, _6) m(d, 41, _7) m(d, 40, _8)           \
+    m(d, 39, _9) m(d, 38, _10) m(d, 37, _11) m(d, 36, _12) m(d, 35, _13)       \
+    m(d, 34, _14) m(d, 33, _15) m(d, 32, _16)                                  \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M49(m, d, _1, ...) m(d, 48, _1)                           \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M50(m, d, _1, _2, ...) m(d, 49, _1) m(d, 48, _2)          \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M51(m, d, _1, _2, _3, ...) m(d, 50, _1) m(d, 49, _2)      \
+    m(d, 48, _3) BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M52(m, d, _1, _2, _3, _4, ...) m(d, 51, _1) m(d, 50, _2)  \
+    m(d, 49, _3) m(d, 48, _4)                                                  \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M53(m, d, _1, _2, _3, _4, _5, ...) m(d, 52, _1)           \
+    m(d, 51, _2) m(d, 50, _3) m(d, 49, _4) m(d, 48, _5)                        \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M54(m, d, _1, _2, _3, _4, _5, _6, ...) m(d, 53, _1)       \
+    m(d, 52, _2) m(d, 51, _3) m(d, 50, _4) m(d, 49, _5) m(d, 48, _6)           \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M55(m, d, _1, _2, _3, _4, _5, _6, _7, ...) m(d, 54, _1)   \
+    m(d, 53, _2) m(d, 52, _3) m(d, 51, _4) m(d, 50, _5) m(d, 49, _6)           \
+    m(d, 48, _7) BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M56(m, d, _1, _2, _3, _4, _5, _6, _7, _8, ...)            \
+    m(d, 55, _1) m(d, 54, _2) m(d, 53, _3) m(d, 52, _4) m(d, 51, _5)           \
+    m(d, 50, _6) m(d, 49, _7) m(d, 48, _8)                                     \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M57(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, ...)        \
+    m(d, 56, _1) m(d, 55, _2) m(d, 54, _3) m(d, 53, _4) m(d, 52, _5)           \
+    m(d, 51, _6) m(d, 50, _7) m(d, 49, _8) m(d, 48, _9)                        \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M58(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, ...)   \
+    m(d, 57, _1) m(d, 56, _2) m(d, 55, _3) m(d, 54, _4) m(d, 53, _5)           \
+    m(d, 52, _6) m(d, 51, _7) m(d, 50, _8) m(d, 49, _9) m(d, 48, _10)          \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M59(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    ...) m(d, 58, _1) m(d, 57, _2) m(d, 56, _3) m(d, 55, _4) m(d, 54, _5)      \
+    m(d, 53, _6) m(d, 52, _7) m(d, 51, _8) m(d, 50, _9) m(d, 49, _10)          \
+    m(d, 48, _11) BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M60(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, ...) m(d, 59, _1) m(d, 58, _2) m(d, 57, _3) m(d, 56, _4) m(d, 55, _5) \
+    m(d, 54, _6) m(d, 53, _7) m(d, 52, _8) m(d, 51, _9) m(d, 50, _10)          \
+    m(d, 49, _11) m(d, 48, _12)                                                \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M61(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, ...) m(d, 60, _1) m(d, 59, _2) m(d, 58, _3) m(d, 57, _4)         \
+    m(d, 56, _5) m(d, 55, _6) m(d, 54, _7) m(d, 53, _8) m(d, 52, _9)           \
+    m(d, 51, _10) m(d, 50, _11) m(d, 49, _12) m(d, 48, _13)                    \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M62(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, ...) m(d, 61, _1) m(d, 60, _2) m(d, 59, _3) m(d, 58, _4)    \
+    m(d, 57, _5) m(d, 56, _6) m(d, 55, _7) m(d, 54, _8) m(d, 53, _9)           \
+    m(d, 52, _10) m(d, 51, _11) m(d, 50, _12) m(d, 49, _13) m(d, 48, _14)      \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M63(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15, ...) m(d, 62, _1) m(d, 61, _2) m(d, 60, _3)            \
+    m(d, 59, _4) m(d, 58, _5) m(d, 57, _6) m(d, 56, _7) m(d, 55, _8)           \
+    m(d, 54, _9) m(d, 53, _10) m(d, 52, _11) m(d, 51, _12) m(d, 50, _13)       \
+    m(d, 49, _14) m(d, 48, _15)                                                \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_M64(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15, _16, ...) m(d, 63, _1) m(d, 62, _2) m(d, 61, _3)       \
+    m(d, 60, _4) m(d, 59, _5) m(d, 58, _6) m(d, 57, _7) m(d, 56, _8)           \
+    m(d, 55, _9) m(d, 54, _10) m(d, 53, _11) m(d, 52, _12) m(d, 51, _13)       \
+    m(d, 50, _14) m(d, 49, _15) m(d, 48, _16)                                  \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L48(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_L32(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15, _16, ...) m(d, 31, _1) m(d, 30, _2) m(d, 29, _3)       \
+    m(d, 28, _4) m(d, 27, _5) m(d, 26, _6) m(d, 25, _7) m(d, 24, _8)           \
+    m(d, 23, _9) m(d, 22, _10) m(d, 21, _11) m(d, 20, _12) m(d, 19, _13)       \
+    m(d, 18, _14) m(d, 17, _15) m(d, 16, _16)                                  \
+    BETTER_ENUMS_ID(BETTER_ENUMS_M16(m, d, __VA_ARGS__))
+#define BETTER_ENUMS_L48(m, d, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11,   \
+    _12, _13, _14, _15, _16, ...) m(d, 47, _1) m(d, 46, _2) m(d, 45, _3)       \
+    m(d, 44, _4) m(d, 43, _5) m(d, 42, _6) m(d, 41, _7) m(d, 40, _8)           \
+    m(d, 39, _9) m(d, 38, _10) m(d, 37, _11) m(d, 36, _12) m(d, 35, _13)       \
+    m(d, 34, _14) m(d, 33, _15) m(d, 32, _16)                                  \
+    BETTER_ENUMS_ID(BETTER_ENUMS_L32(m, d, __VA_ARGS__))
 
 #define BETTER_ENUMS_PP_COUNT_IMPL(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10,    \
     _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, \
@@ -296,16 +528,14 @@
         23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, \
         4, 3, 2, 1))
 
-#define BETTER_ENUMS_ITERATE(X, f, l) X(f, l, 0) X(f, l, 1) X(f, l, 2)         \
-    X(f, l, 3) X(f, l, 4) X(f, l, 5) X(f, l, 6) X(f, l, 7) X(f, l, 8)          \
-    X(f, l, 9) X(f, l, 10) X(f, l, 11) X(f, l, 12) X(f, l, 13) X(f, l, 14)     \
-    X(f, l, 15) X(f, l, 16) X(f, l, 17) X(f, l, 18) X(f, l, 19) X(f, l, 20)    \
-    X(f, l, 21) X(f, l, 22) X(f, l, 23)
-
 #endif // #ifdef BETTER_ENUMS_MACRO_FILE else case
 
 
 
+// The rest of the library, up to the enum declaration macros, comes from the
+// module when it is imported.
+#ifndef BETTER_ENUMS_MODULE_IMPORTED
+
 namespace better_enums {
 
 
@@ -349,7 +579,7 @@ struct optional {
 };
 
 template <typename CastTo, typename Element>
-BETTER_ENUMS_CONSTEXPR_ static optional<CastTo>
+BETTER_ENUMS_CONSTEXPR_ BETTER_ENUMS_STATIC_ optional<CastTo>
 _map_index(const Element *array, optional<std::size_t> index)
 {
     return index ? static_cast<CastTo>(array[*index]) : optional<CastTo>();
@@ -372,27 +602,114 @@ _map_index(const Element *array, optional<std::size_t> index)
 
 BETTER_ENUMS_IF_EXCEPTIONS(
 template <typename T>
-BETTER_ENUMS_CONSTEXPR_ static T _or_throw(optional<T> maybe,
-                                           const char *message)
+BETTER_ENUMS_CONSTEXPR_ BETTER_ENUMS_STATIC_ T
+_or_throw(optional<T> maybe, const char *message)
 {
     BETTER_ENUMS_OR_THROW
 }
 )
 
 template <typename T>
-BETTER_ENUMS_CONSTEXPR_ static T* _or_null(optional<T*> maybe)
+BETTER_ENUMS_CONSTEXPR_ BETTER_ENUMS_STATIC_ T* _or_null(optional<T*> maybe)
 {
     return maybe ? *maybe : BETTER_ENUMS_NULLPTR;
 }
 
 template <typename T>
-BETTER_ENUMS_CONSTEXPR_ static T _or_zero(optional<T> maybe)
+BETTER_ENUMS_CONSTEXPR_ BETTER_ENUMS_STATIC_ T _or_zero(optional<T> maybe)
 {
     return maybe ? *maybe : T::_from_integral_unchecked(0);
 }
 
 
 
+// Conversion hook. The operation passed to BETTER_ENUMS_CONVERSION_HOOK.
+// Conversions from values, which include _to_string and _to_index, are reported
+// as conversion_from_value, and conversions from names as one of the next two.
+// The throwing conversions report the lookup that failed before throwing.
+#ifdef BETTER_ENUMS_CONVERSION_HOOK
+
+enum conversion {
+    conversion_from_value,
+    conversion_from_name,
+    conversion_from_name_nocase,
+    conversion_initialize
+};
+
+// Calls the hook, unless evaluated at compile time. The call is then in the
+// branch that is not taken, so the hook needn't be constexpr.
+BETTER_ENUMS_CONSTEXPR_ inline int _report(const char *enum_name,
+                                           conversion operation, bool found,
+                                           std::size_t depth)
+{
+    return
+        BETTER_ENUMS_IS_CONSTANT_EVALUATED() ? 0 :
+        (static_cast<void>(
+            BETTER_ENUMS_CONVERSION_HOOK(enum_name, operation, found, depth)),
+         0);
+}
+
+#endif // #ifdef BETTER_ENUMS_CONVERSION_HOOK
+
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t
+_map_length(const std::size_t *lengths, optional<std::size_t> index)
+{
+    return index ? lengths[*index] : 0;
+}
+
+// Output for _write_to. Each returns one past the last character written, or a
+// null pointer if the characters don't fit between first and last. Nothing is
+// written in that case, and the output is never null-terminated.
+inline char* _write_chars(const char *s, std::size_t length, char *first,
+                          char *last)
+{
+    if (static_cast<std::size_t>(last - first) < length)
+        return BETTER_ENUMS_NULLPTR;
+
+    std::memcpy(first, s, length);
+    return first + length;
+}
+
+// Writes value in decimal. Each bit adds less than a third of a decimal digit,
+// so the digits fit in sizeof(Integral) * CHAR_BIT / 3 + 1 characters, to which
+// one is added for the sign. Negative values are divided while they are still
+// negative, so that the most negative value does not overflow. This relies on
+// division truncating towards zero, which C++11 requires, and which C++98
+// compilers do.
+template <typename Integral>
+inline char* _write_integral(Integral value, char *first, char *last)
+{
+    char            digits[sizeof(Integral) * CHAR_BIT / 3 + 2];
+    char            *end = digits + sizeof(digits);
+    char            *digit = end;
+    const bool      negative = value != 0 && !(value > 0);
+
+    do {
+        int remainder = static_cast<int>(value % 10);
+        *--digit = static_cast<char>('0' + (negative ? -remainder : remainder));
+        value = static_cast<Integral>(value / 10);
+    } while (value != 0);
+
+    if (negative)
+        *--digit = '-';
+
+    return _write_chars(digit, static_cast<std::size_t>(end - digit), first,
+                        last);
+}
+
+BETTER_ENUMS_IF_STRING_VIEW(
+constexpr inline std::string_view
+_map_name(const char * const *names, const std::size_t *lengths,
+          optional<std::size_t> index)
+{
+    return
+        index ? std::string_view(names[*index], lengths[*index]) :
+        std::string_view();
+}
+)
+
+
+
 // Functional sequencing. This is essentially a comma operator wrapped in a
 // constexpr function. g++ 4.7 doesn't "accept" integral constants in the second
 // position for the comma operator, and emits an external symbol, which then
@@ -449,14 +766,15 @@ struct _iterable {
 
 // String routines.
 
-BETTER_ENUMS_CONSTEXPR_ static const char       *_name_enders = "= \t\n";
+BETTER_ENUMS_CONSTEXPR_ BETTER_ENUMS_STATIC_ const char *_name_enders =
+    "= \t\n";
 
-BETTER_ENUMS_CONSTEXPR_ inline bool _ends_name(char c, std::size_t index = 0)
+// Equivalent to searching _name_enders, including its terminating null
+// character, but without recursion, since this is evaluated for every
+// character of every constant name at compile time.
+BETTER_ENUMS_CONSTEXPR_ inline bool _ends_name(char c)
 {
-    return
-        c == _name_enders[index] ? true  :
-        _name_enders[index] == '\0' ? false :
-        _ends_name(c, index + 1);
+    return c == '=' || c == ' ' || c == '\t' || c == '\n' || c == '\0';
 }
 
 BETTER_ENUMS_CONSTEXPR_ inline bool _has_initializer(const char *s,
@@ -474,10 +792,9 @@ _constant_length(const char *s, std::size_t index = 0)
     return _ends_name(s[index]) ? index : _constant_length(s, index + 1);
 }
 
-BETTER_ENUMS_CONSTEXPR_ inline char
-_select(const char *from, std::size_t from_length, std::size_t index)
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t _larger(std::size_t a, std::size_t b)
 {
-    return index >= from_length ? '\0' : from[index];
+    return a < b ? b : a;
 }
 
 BETTER_ENUMS_CONSTEXPR_ inline char _to_lower_ascii(char c)
@@ -485,45 +802,1050 @@ BETTER_ENUMS_CONSTEXPR_ inline char _to_lower_ascii(char c)
     return c >= 0x41 && c <= 0x5A ? static_cast<char>(c + 0x20) : c;
 }
 
+// Reference names passed to _names_match and _names_match_nocase are either
+// the first length characters of a buffer, which need not be null-terminated,
+// or, if length is _null_terminated, a null-terminated string.
+BETTER_ENUMS_CONSTEXPR_ BETTER_ENUMS_STATIC_ const std::size_t
+    _null_terminated = static_cast<std::size_t>(-1);
+
+BETTER_ENUMS_CONSTEXPR_ inline bool
+_reference_ends(const char *referenceName, std::size_t length,
+                std::size_t index)
+{
+    return
+        length == _null_terminated ? referenceName[index] == '\0' :
+        index == length;
+}
+
 BETTER_ENUMS_CONSTEXPR_ inline bool _names_match(const char *stringizedName,
                                                  const char *referenceName,
+                                                 std::size_t length,
                                                  std::size_t index = 0)
 {
     return
-        _ends_name(stringizedName[index]) ? referenceName[index] == '\0' :
-        referenceName[index] == '\0' ? false :
+        _ends_name(stringizedName[index]) ?
+            _reference_ends(referenceName, length, index) :
+        _reference_ends(referenceName, length, index) ? false :
         stringizedName[index] != referenceName[index] ? false :
-        _names_match(stringizedName, referenceName, index + 1);
+        _names_match(stringizedName, referenceName, length, index + 1);
+}
+
+BETTER_ENUMS_CONSTEXPR_ inline bool
+_names_match_nocase(const char *stringizedName, const char *referenceName,
+                    std::size_t length, std::size_t index = 0)
+{
+    return
+        _ends_name(stringizedName[index]) ?
+            _reference_ends(referenceName, length, index) :
+        _reference_ends(referenceName, length, index) ? false :
+        _to_lower_ascii(stringizedName[index]) !=
+            _to_lower_ascii(referenceName[index]) ? false :
+        _names_match_nocase(stringizedName, referenceName, length, index + 1);
+}
+
+// Comparison of exactly length characters, used once the length of a candidate
+// name is known to equal that of the input. Characters are compared a word at a
+// time. Each word is assembled from bytes with shifts, which gcc and clang
+// compile into a single load, and which, unlike std::memcpy, can be evaluated
+// at compile time. Case is folded in all bytes of a word at once, by computing
+// which bytes are in the range 'A' to 'Z' without carries between bytes, and
+// setting bit 5 in them, exactly as _to_lower_ascii would.
+BETTER_ENUMS_CONSTEXPR_ inline unsigned long
+_load_byte(const char *s, std::size_t index)
+{
+    return static_cast<unsigned long>(static_cast<unsigned char>(s[index]));
+}
+
+BETTER_ENUMS_CONSTEXPR_ inline unsigned long _load_32_bits(const char *s)
+{
+    return
+        _load_byte(s, 0) | _load_byte(s, 1) << 8 | _load_byte(s, 2) << 16 |
+        _load_byte(s, 3) << 24;
+}
+
+// The second half is shifted in two steps, so that the shift is not wider than
+// unsigned long when that is 32 bits, and the branch is not taken.
+BETTER_ENUMS_CONSTEXPR_ inline unsigned long _load_word(const char *s)
+{
+    return
+        sizeof(unsigned long) == 4 ? _load_32_bits(s) :
+        _load_32_bits(s) | _load_32_bits(s + 4) << 16 << 16;
+}
+
+BETTER_ENUMS_CONSTEXPR_ inline unsigned long _repeat_byte(unsigned long byte)
+{
+    return ~0UL / 0xff * byte;
+}
+
+BETTER_ENUMS_CONSTEXPR_ inline unsigned long _to_lower_word(unsigned long word)
+{
+    return
+        word |
+        (((word & ~_repeat_byte(0x80)) + _repeat_byte(0x80 - 'A')) &
+         ~((word & ~_repeat_byte(0x80)) + _repeat_byte(0x80 - 'Z' - 1)) &
+         ~word & _repeat_byte(0x80)) >> 2;
+}
+
+BETTER_ENUMS_RELAXED_CONSTEXPR_ inline bool
+_names_equal(const char *a, const char *b, std::size_t length, bool nocase)
+{
+    std::size_t     index = 0;
+
+    for (; length - index >= sizeof(unsigned long);
+         index += sizeof(unsigned long)) {
+
+        unsigned long   a_word = _load_word(a + index);
+        unsigned long   b_word = _load_word(b + index);
+
+        if (nocase ?
+                _to_lower_word(a_word) != _to_lower_word(b_word) :
+                a_word != b_word) {
+
+            return false;
+        }
+    }
+
+    for (; index < length; ++index) {
+        if (nocase ?
+                _to_lower_ascii(a[index]) != _to_lower_ascii(b[index]) :
+                a[index] != b[index]) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline void _trim_names(const char * const *raw_names,
+                        const char **trimmed_names, std::size_t *lengths,
+                        char *storage, std::size_t count)
+{
+    std::size_t     offset = 0;
+
+    for (std::size_t index = 0; index < count; ++index) {
+        trimmed_names[index] = storage + offset;
+
+        std::size_t trimmed_length =
+            std::strcspn(raw_names[index], _name_enders);
+        storage[offset + trimmed_length] = '\0';
+        lengths[index] = trimmed_length;
+
+        std::size_t raw_length = std::strlen(raw_names[index]);
+        offset += raw_length + 1;
+    }
+}
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+// In C++11, a constexpr function can't fill in an array in a loop, so each name
+// that has an initializer is copied into its own array by a constructor, which
+// expands a pack of the indices of its characters. The indices are generated by
+// recursion on the length of the name, so there is no limit on the length, and
+// names of the same length share the instantiations.
+template <std::size_t... Indices>
+struct _indices { };
+
+template <std::size_t Length, std::size_t... Indices>
+struct _make_indices : _make_indices<Length - 1, Length - 1, Indices...> { };
+
+template <std::size_t... Indices>
+struct _make_indices<0, Indices...> {
+    typedef _indices<Indices...>    type;
+};
+
+template <std::size_t Length>
+struct _trimmed_name {
+    const char      characters[Length + 1];
+
+    template <std::size_t... Indices>
+    constexpr _trimmed_name(const char *raw_name, _indices<Indices...>) :
+        characters{raw_name[Indices]..., '\0'} { }
+};
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+
+// With relaxed constexpr, names are trimmed at compile time by copying each
+// one, up to its initializer, into a single storage array. This is one loop
+// over the characters of all names, instead of the template instantiations
+// used by BETTER_ENUMS_CXX11_FULL_CONSTEXPR_TRIM_STRINGS_ARRAYS.
+constexpr std::size_t _trimmed_size(const char * const *raw_names,
+                                    std::size_t count)
+{
+    std::size_t     size = 0;
+
+    for (std::size_t index = 0; index < count; ++index)
+        size += _constant_length(raw_names[index]) + 1;
+
+    return size;
+}
+
+template <std::size_t Size, std::size_t StorageSize>
+struct _trimmed_names {
+    const char      *names[Size];
+    std::size_t     lengths[Size];
+    char            storage[StorageSize];
+
+    constexpr _trimmed_names(const char * const *raw_names) :
+        names(), lengths(), storage()
+    {
+        std::size_t offset = 0;
+
+        for (std::size_t index = 0; index < Size; ++index) {
+            const char  *raw_name = raw_names[index];
+            std::size_t length = 0;
+
+            for (; !_ends_name(raw_name[length]); ++length)
+                storage[offset + length] = raw_name[length];
+
+            names[index] = storage + offset;
+            lengths[index] = length;
+
+            offset += length + 1;
+        }
+    }
+};
+
+#endif // #ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+
+
+
+// Index tables. Entries are indices of declared constants, or the number of
+// constants to indicate that there is no constant. The element type is the
+// smallest one that can hold that number.
+
+template <std::size_t Size, bool Byte = (Size < 0xff)>
+struct _index_type {
+    typedef unsigned char type;
+};
+
+template <std::size_t Size>
+struct _index_type<Size, false> {
+    typedef unsigned short type;
+};
+
+
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+// Value lookup. Most enums are sequential: each constant is one greater than
+// the previous one. The offset of a value from the first value is then already
+// its index, so lookup is a single bounds check. Checking that an enum is
+// sequential takes one scan, which splits the array in halves, so its recursion
+// depth is logarithmic in the number of constants.
+//
+// With relaxed constexpr, enums that are dense, i.e. whose values all fall into
+// a range less than twice the number of constants, also get a table, indexed
+// by offset from the minimum value, that maps each value to the index of the
+// first constant declared with that value. Building the table is the expensive
+// part, so it is built only for enums that are dense but not sequential. Other
+// enums only pay for the one loop over their values that tells them apart.
+// Without relaxed constexpr, filling in such a table takes time quadratic in
+// the number of constants, which is too slow, so non-sequential enums fall back
+// to a linear scan.
+//
+// Offsets are computed in unsigned long long, so that computing the range of an
+// enum with widely-spaced values never overflows.
+
+template <typename Integral>
+BETTER_ENUMS_CONSTEXPR_ inline unsigned long long
+_offset(Integral value, Integral base)
+{
+    return
+        static_cast<unsigned long long>(value) -
+        static_cast<unsigned long long>(base);
+}
+
+template <typename Element>
+BETTER_ENUMS_CONSTEXPR_ inline bool
+_sequential(const Element *values, std::size_t begin, std::size_t end)
+{
+    return
+        end - begin == 1 ?
+            _offset(values[begin]._value, values[0]._value) == begin :
+        _sequential(values, begin, begin + (end - begin) / 2) &&
+        _sequential(values, begin + (end - begin) / 2, end);
+}
+
+template <typename Integral>
+BETTER_ENUMS_CONSTEXPR_ inline optional<std::size_t>
+_sequential_find(std::size_t size, Integral base, Integral value)
+{
+    return
+        _offset(value, base) >= size ? optional<std::size_t>() :
+        optional<std::size_t>(static_cast<std::size_t>(_offset(value, base)));
+}
+
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+
+enum _value_shape { _shape_sequential, _shape_dense, _shape_sparse };
+
+template <typename Element>
+constexpr _value_shape _shape(const Element *values, std::size_t size)
+{
+    typename Element::_integral minimum = values[0]._value;
+    typename Element::_integral maximum = values[0]._value;
+    bool                        sequential = true;
+
+    for (std::size_t index = 1; index < size; ++index) {
+        if (_offset(values[index]._value, values[0]._value) != index)
+            sequential = false;
+        if (values[index]._value < minimum)
+            minimum = values[index]._value;
+        if (values[index]._value > maximum)
+            maximum = values[index]._value;
+    }
+
+    return
+        sequential ? _shape_sequential :
+        _offset(maximum, minimum) < 2 * size ? _shape_dense : _shape_sparse;
+}
+
+template <typename Integral, typename Index, std::size_t Size>
+struct _value_table {
+    Integral    base;
+    Index       slots[2 * Size];
+
+    template <typename Element>
+    constexpr _value_table(const Element *values) :
+        base(values[0]._value), slots()
+    {
+        for (std::size_t index = 1; index < Size; ++index) {
+            if (values[index]._value < base)
+                base = values[index]._value;
+        }
+
+        for (std::size_t slot = 0; slot < 2 * Size; ++slot)
+            slots[slot] = static_cast<Index>(Size);
+
+        // Going backwards leaves the first constant with each value in its
+        // slot.
+        for (std::size_t index = Size; index > 0; --index) {
+            slots[_offset(values[index - 1]._value, base)] =
+                static_cast<Index>(index - 1);
+        }
+    }
+};
+
+// Enums that are not dense get an empty table of this type instead, which is
+// shared by all enums with the same underlying type.
+template <typename Integral, typename Index>
+struct _value_table<Integral, Index, 0> {
+    Integral    base;
+    Index       slots[1];
+
+    constexpr _value_table(const void*) : base(), slots() { }
+};
+
+template <typename Index, typename Integral>
+BETTER_ENUMS_CONSTEXPR_ inline optional<std::size_t>
+_dense_find(const Index *table, std::size_t size, Integral base,
+            Integral value)
+{
+    return
+        _offset(value, base) >= 2 * size ? optional<std::size_t>() :
+        table[_offset(value, base)] == size ? optional<std::size_t>() :
+        optional<std::size_t>(table[_offset(value, base)]);
+}
+
+#endif // #ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+
+
+
+// The exact lengths of the declared names, and of the longest name.
+// Enum::_max_name_length_constant is only a bound, so that every enum does not
+// pay for finding the ends of its names at compile time. These templates find
+// them only when they are instantiated. The maximum halves the constants at
+// each step, so that the recursion depth is only the logarithm of their number.
+
+template <typename Enum>
+constexpr std::size_t declared_name_length(std::size_t index)
+{
+    return _constant_length(Enum::_declared_name(index));
+}
+
+template <typename Enum>
+constexpr std::size_t _max_declared_length(std::size_t begin, std::size_t end)
+{
+    return
+        end - begin == 1 ?
+            declared_name_length<Enum>(begin) :
+        _larger(_max_declared_length<Enum>(begin, begin + (end - begin) / 2),
+                _max_declared_length<Enum>(begin + (end - begin) / 2, end));
+}
+
+template <typename Enum>
+constexpr std::size_t max_name_length()
+{
+    return _max_declared_length<Enum>(0, Enum::_size_constant);
+}
+
+
+
+// Schema fingerprint. Each constant is hashed on its own, from its name, with
+// 64-bit FNV-1a, and from its value, and the hashes are then combined pairwise
+// in a balanced tree, so that the recursion depth is only logarithmic in the
+// number of constants. Combining is not commutative, so the fingerprint also
+// depends on the order of the constants. Names are hashed up to _ends_name, so
+// raw and trimmed names give the same result. Values are first converted to
+// unsigned long long, so the underlying type only matters if it changes the
+// values.
+
+constexpr unsigned long long _fingerprint_shift(unsigned long long h,
+                                                unsigned shift,
+                                                unsigned long long multiplier)
+{
+    return (h ^ (h >> shift)) * multiplier;
+}
+
+// The finalizer of splitmix64.
+constexpr unsigned long long _fingerprint_mix(unsigned long long h)
+{
+    return
+        _fingerprint_shift(
+            _fingerprint_shift(
+                _fingerprint_shift(h, 30, 0xbf58476d1ce4e5b9ULL),
+                27, 0x94d049bb133111ebULL),
+            31, 1);
+}
+
+constexpr unsigned long long
+_fingerprint_name(const char *name,
+                  unsigned long long hash = 0xcbf29ce484222325ULL)
+{
+    return
+        _ends_name(*name) ? hash :
+        _fingerprint_name(name + 1,
+                          (hash ^ static_cast<unsigned char>(*name)) *
+                              0x100000001b3ULL);
+}
+
+template <typename Enum>
+constexpr unsigned long long _fingerprint(std::size_t begin, std::size_t end)
+{
+    return
+        end - begin == 1 ?
+            _fingerprint_mix(
+                _fingerprint_name(Enum::_declared_name(begin)) ^
+                _fingerprint_mix(
+                    static_cast<unsigned long long>(
+                        Enum::_values()[begin]._value))) :
+        _fingerprint_mix(
+            _fingerprint<Enum>(begin, begin + (end - begin) / 2) *
+                0x100000001b3ULL ^
+            _fingerprint<Enum>(begin + (end - begin) / 2, end));
+}
+
+// A namespace-scope template, rather than a member of each enum, so that it is
+// only compiled for enums whose fingerprint is used.
+template <typename Enum>
+constexpr unsigned long long fingerprint()
+{
+    return
+        _fingerprint_mix(
+            _fingerprint<Enum>(0, Enum::_size_constant) ^
+            Enum::_size_constant);
+}
+
+
+
+// visit. When the values of the constants are dense, so that they span no more
+// than twice as many integers as there are constants, the offset of the value
+// from the least value selects a case of a switch statement, which compilers
+// turn into a jump table. Each case calls the visitor directly, with the first
+// constant declared with that value, so that the call can be inlined. The
+// cases are written out in blocks of 64, and each block is a template, so the
+// switch is only instantiated for enums that are visited. Sparse enums whose
+// values are strictly increasing are searched by a balanced tree of
+// comparisons of values instead, as compilers do for sparse switches. For
+// other sparse enums, the switch selects a constant by _to_index().
+
+template <typename Element>
+constexpr bool _increasing(const Element *values, std::size_t begin,
+                           std::size_t end)
+{
+    return
+        end - begin == 1 ? true :
+        end - begin == 2 ? values[begin]._value < values[begin + 1]._value :
+        _increasing(values, begin, begin + (end - begin) / 2 + 1) &&
+        _increasing(values, begin + (end - begin) / 2, end);
+}
+
+template <typename Integral>
+constexpr Integral _lesser(Integral first, Integral second)
+{
+    return second < first ? second : first;
+}
+
+template <typename Integral>
+constexpr Integral _greater(Integral first, Integral second)
+{
+    return first < second ? second : first;
+}
+
+template <typename Element>
+constexpr typename Element::_integral _least(const Element *values,
+                                             std::size_t begin, std::size_t end)
+{
+    return
+        end - begin == 1 ? values[begin]._value :
+        _lesser(_least(values, begin, begin + (end - begin) / 2),
+                _least(values, begin + (end - begin) / 2, end));
+}
+
+template <typename Element>
+constexpr typename Element::_integral _greatest(const Element *values,
+                                                std::size_t begin,
+                                                std::size_t end)
+{
+    return
+        end - begin == 1 ? values[begin]._value :
+        _greater(_greatest(values, begin, begin + (end - begin) / 2),
+                 _greatest(values, begin + (end - begin) / 2, end));
+}
+
+// Index of the first constant in [begin, end) whose value is at the given
+// offset from least, or the greatest std::size_t if there is none. The search
+// is halved at each step, so that its depth is logarithmic.
+template <typename Element>
+constexpr std::size_t _first_at(const Element *values, std::size_t begin,
+                                std::size_t end,
+                                typename Element::_integral least,
+                                unsigned long long offset)
+{
+    return
+        end - begin == 1 ?
+            _offset(values[begin]._value, least) == offset ?
+                begin : ~static_cast<std::size_t>(0) :
+        _lesser(_first_at(values, begin, begin + (end - begin) / 2, least,
+                          offset),
+                _first_at(values, begin + (end - begin) / 2, end, least,
+                          offset));
+}
+
+enum _visit_method { _visit_by_offset, _visit_by_value, _visit_by_index };
+
+template <typename Enum>
+constexpr _visit_method _visit_method_of()
+{
+    return
+        _offset(_greatest(Enum::_values().begin(), 0, Enum::_size_constant),
+                _least(Enum::_values().begin(), 0, Enum::_size_constant)) <
+            2 * static_cast<unsigned long long>(Enum::_size_constant) ?
+                _visit_by_offset :
+        _increasing(Enum::_values().begin(), 0, Enum::_size_constant) ?
+            _visit_by_value : _visit_by_index;
+}
+
+// Maps an enum value to a key, which is a case of the switch, and each key to
+// the index of the constant passed to the visitor. Keys that are not those of
+// any constant, including those of invalid values, which can only be created by
+// _from_integral_unchecked, map to the first constant.
+template <typename Enum, _visit_method Method>
+struct _visit_key;
+
+template <typename Enum>
+struct _visit_key<Enum, _visit_by_offset> {
+    constexpr static unsigned long long of(Enum value)
+    {
+        return
+            _offset(value._value,
+                    _least(Enum::_values().begin(), 0, Enum::_size_constant));
+    }
+
+    constexpr static unsigned long long size()
+    {
+        return
+            _offset(_greatest(Enum::_values().begin(), 0,
+                              Enum::_size_constant),
+                    _least(Enum::_values().begin(), 0,
+                           Enum::_size_constant)) + 1;
+    }
+
+    constexpr static std::size_t index(unsigned long long key)
+    {
+        return
+            _first_at(Enum::_values().begin(), 0, Enum::_size_constant,
+                      _least(Enum::_values().begin(), 0,
+                             Enum::_size_constant),
+                      key) < Enum::_size_constant ?
+                _first_at(Enum::_values().begin(), 0, Enum::_size_constant,
+                          _least(Enum::_values().begin(), 0,
+                                 Enum::_size_constant),
+                          key) :
+                0;
+    }
+};
+
+template <typename Enum>
+struct _visit_key<Enum, _visit_by_index> {
+    constexpr static unsigned long long of(Enum value)
+        { return value._to_index(); }
+
+    constexpr static unsigned long long size()
+        { return Enum::_size_constant; }
+
+    constexpr static std::size_t index(unsigned long long key)
+        { return key < Enum::_size_constant ? key : 0; }
+};
+
+template <typename T>
+T&& _declval();
+
+template <typename Enum, typename Visitor>
+struct _visit_result {
+    typedef
+        decltype(_declval<Visitor>()(
+            std::integral_constant<
+                typename Enum::_enumerated,
+                static_cast<typename Enum::_enumerated>(
+                    Enum::_values()[0]._value)>()))
+        type;
+};
+
+template <typename Enum, std::size_t Index, typename Visitor>
+BETTER_ENUMS_RELAXED_CONSTEXPR_ inline
+typename _visit_result<Enum, Visitor>::type
+_visit_constant(Visitor &&visitor)
+{
+    return
+        static_cast<Visitor&&>(visitor)(
+            std::integral_constant<
+                typename Enum::_enumerated,
+                static_cast<typename Enum::_enumerated>(
+                    Enum::_values()[Index]._value)>());
+}
+
+#define BETTER_ENUMS_VISIT_CASE(offset)                                        \
+    case offset:                                                               \
+        return                                                                 \
+            _visit_constant<Enum,                                              \
+                            _visit_key<Enum, Method>::index(Begin + offset)>(  \
+                static_cast<Visitor&&>(visitor));
+
+#define BETTER_ENUMS_VISIT_CASES(offset)                                       \
+    BETTER_ENUMS_VISIT_CASE(offset)     BETTER_ENUMS_VISIT_CASE(offset + 1)    \
+    BETTER_ENUMS_VISIT_CASE(offset + 2) BETTER_ENUMS_VISIT_CASE(offset + 3)    \
+    BETTER_ENUMS_VISIT_CASE(offset + 4) BETTER_ENUMS_VISIT_CASE(offset + 5)    \
+    BETTER_ENUMS_VISIT_CASE(offset + 6) BETTER_ENUMS_VISIT_CASE(offset + 7)
+
+// Each block handles the 64 keys starting at Begin, and passes the rest to the
+// next block. Only the first block is reached by keys less than Begin + 64, so
+// the default case of the last block catches every key that is out of range.
+template <typename Enum, _visit_method Method, unsigned long long Begin,
+          bool Last = (Begin + 64 >= _visit_key<Enum, Method>::size())>
+struct _visit_block {
+    template <typename Visitor>
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static
+    typename _visit_result<Enum, Visitor>::type
+    visit(unsigned long long key, Visitor &&visitor)
+    {
+        switch (key - Begin) {
+            BETTER_ENUMS_VISIT_CASES(0)  BETTER_ENUMS_VISIT_CASES(8)
+            BETTER_ENUMS_VISIT_CASES(16) BETTER_ENUMS_VISIT_CASES(24)
+            BETTER_ENUMS_VISIT_CASES(32) BETTER_ENUMS_VISIT_CASES(40)
+            BETTER_ENUMS_VISIT_CASES(48) BETTER_ENUMS_VISIT_CASES(56)
+
+            default:
+                return
+                    _visit_block<Enum, Method, Begin + 64>::visit(
+                        key, static_cast<Visitor&&>(visitor));
+        }
+    }
+};
+
+template <typename Enum, _visit_method Method, unsigned long long Begin>
+struct _visit_block<Enum, Method, Begin, true> {
+    template <typename Visitor>
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static
+    typename _visit_result<Enum, Visitor>::type
+    visit(unsigned long long key, Visitor &&visitor)
+    {
+        switch (key - Begin) {
+            BETTER_ENUMS_VISIT_CASES(0)  BETTER_ENUMS_VISIT_CASES(8)
+            BETTER_ENUMS_VISIT_CASES(16) BETTER_ENUMS_VISIT_CASES(24)
+            BETTER_ENUMS_VISIT_CASES(32) BETTER_ENUMS_VISIT_CASES(40)
+            BETTER_ENUMS_VISIT_CASES(48) BETTER_ENUMS_VISIT_CASES(56)
+
+            default:
+                return
+                    _visit_constant<Enum, 0>(static_cast<Visitor&&>(visitor));
+        }
+    }
+};
+
+// The tree for sparse, strictly increasing values. A leaf checks that the value
+// is that of its constant, and passes invalid values as the first constant.
+template <typename Enum, std::size_t Begin, std::size_t End,
+          bool Leaf = (End - Begin == 1)>
+struct _visit_range {
+    template <typename Visitor>
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static
+    typename _visit_result<Enum, Visitor>::type
+    visit(typename Enum::_integral value, Visitor &&visitor)
+    {
+        return
+            value < Enum::_values()[Begin + (End - Begin) / 2]._value ?
+                _visit_range<Enum, Begin, Begin + (End - Begin) / 2>::visit(
+                    value, static_cast<Visitor&&>(visitor)) :
+                _visit_range<Enum, Begin + (End - Begin) / 2, End>::visit(
+                    value, static_cast<Visitor&&>(visitor));
+    }
+};
+
+template <typename Enum, std::size_t Begin, std::size_t End>
+struct _visit_range<Enum, Begin, End, true> {
+    template <typename Visitor>
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static
+    typename _visit_result<Enum, Visitor>::type
+    visit(typename Enum::_integral value, Visitor &&visitor)
+    {
+        return
+            value == Enum::_values()[Begin]._value ?
+                _visit_constant<Enum, Begin>(static_cast<Visitor&&>(visitor)) :
+                _visit_constant<Enum, 0>(static_cast<Visitor&&>(visitor));
+    }
+};
+
+template <typename Enum, _visit_method Method = _visit_method_of<Enum>()>
+struct _visit_dispatch {
+    template <typename Visitor>
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static
+    typename _visit_result<Enum, Visitor>::type
+    visit(Enum value, Visitor &&visitor)
+    {
+        return
+            _visit_block<Enum, Method, 0>::visit(
+                _visit_key<Enum, Method>::of(value),
+                static_cast<Visitor&&>(visitor));
+    }
+};
+
+template <typename Enum>
+struct _visit_dispatch<Enum, _visit_by_value> {
+    template <typename Visitor>
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static
+    typename _visit_result<Enum, Visitor>::type
+    visit(Enum value, Visitor &&visitor)
+    {
+        return
+            _visit_range<Enum, 0, Enum::_size_constant>::visit(
+                value._value, static_cast<Visitor&&>(visitor));
+    }
+};
+
+template <typename Enum, typename Visitor>
+BETTER_ENUMS_RELAXED_CONSTEXPR_ inline
+typename _visit_result<Enum, Visitor>::type
+visit(Enum value, Visitor &&visitor)
+{
+    return
+        _visit_dispatch<Enum>::visit(value, static_cast<Visitor&&>(visitor));
+}
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+// Name lookup. Names are kept in a chained hash table with one bucket per
+// constant. The hash looks only at the length of a name and at its first,
+// middle, and last characters, folded to lowercase. Both case-sensitive and
+// case-insensitive lookups can therefore use the same table. Each bucket is
+// checked against the input with _candidate_equal.
+//
+// The table is stored in one array: entry 2 * b is the first constant in bucket
+// b, and entry 2 * i + 1 is the next constant in the same bucket as constant i.
+// Both are the number of constants if there is no such constant.
+//
+// The length of each name is stored next to the table, so that candidates of
+// the wrong length are rejected without comparing any characters. Input longer
+// than the longest constant is rejected before hashing, so the length of
+// null-terminated input never has to be computed past that point.
+
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t _hash_character(char c)
+{
+    return static_cast<unsigned char>(_to_lower_ascii(c));
+}
+
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t
+_name_hash(const char *name, std::size_t length, std::size_t buckets)
+{
+    return
+        length == 0 ? 0 :
+        (((length * 31 + _hash_character(name[0])) * 31 +
+            _hash_character(name[length / 2])) * 31 +
+            _hash_character(name[length - 1])) % buckets;
+}
+
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t
+_bounded_length(const char *s, std::size_t limit, std::size_t index = 0)
+{
+    return
+        index == limit || s[index] == '\0' ? index :
+        _bounded_length(s, limit, index + 1);
+}
+
+// Without relaxed constexpr, only generated enums have a table, and their
+// lookups are still constant expressions, so candidates are compared a
+// character at a time.
+#if defined(BETTER_ENUMS_HAVE_CONSTEXPR) &&                                    \
+    !defined(BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR)
+
+constexpr inline bool _candidate_equal(const char *candidate, const char *name,
+                                       std::size_t length, bool nocase)
+{
+    return
+        nocase ? _names_match_nocase(candidate, name, length) :
+                 _names_match(candidate, name, length);
+}
+
+#else
+
+BETTER_ENUMS_RELAXED_CONSTEXPR_ inline bool
+_candidate_equal(const char *candidate, const char *name, std::size_t length,
+                 bool nocase)
+{
+    return _names_equal(candidate, name, length, nocase);
+}
+
+#endif
+
+template <typename Index>
+BETTER_ENUMS_CONSTEXPR_ inline optional<std::size_t>
+_bucket_find(const char * const *names, const std::size_t *lengths,
+             const Index *buckets, std::size_t size, std::size_t index,
+             const char *name, std::size_t length, bool nocase)
+{
+    return
+        index == size ? optional<std::size_t>() :
+        lengths[index] == length &&
+        _candidate_equal(names[index], name, length, nocase) ?
+            optional<std::size_t>(index) :
+        _bucket_find(names, lengths, buckets, size, buckets[2 * index + 1],
+                     name, length, nocase);
+}
+
+template <typename Index>
+BETTER_ENUMS_CONSTEXPR_ inline optional<std::size_t>
+_hashed_find(const char * const *names, const std::size_t *lengths,
+             const Index *buckets, std::size_t size, std::size_t max_length,
+             const char *name, std::size_t length, bool nocase)
+{
+    return
+        length > max_length ? optional<std::size_t>() :
+        _bucket_find(names, lengths, buckets, size,
+                     buckets[2 * _name_hash(name, length, size)], name, length,
+                     nocase);
+}
+
+// The number of candidates looked at by a lookup that returned index, for the
+// conversion hook: by _linear_find or Enum::_from_value_loop, and by
+// _hashed_find. Input that is too long to be a name is rejected after looking
+// at none.
+#ifdef BETTER_ENUMS_CONVERSION_HOOK
+
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t
+_linear_depth(std::size_t size, optional<std::size_t> index)
+{
+    return index ? *index + 1 : size;
+}
+
+template <typename Index>
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t
+_bucket_depth(const Index *buckets, std::size_t size, std::size_t current,
+              optional<std::size_t> index, std::size_t depth = 0)
+{
+    return
+        current == size ? depth :
+        index && current == *index ? depth + 1 :
+        _bucket_depth(buckets, size, buckets[2 * current + 1], index,
+                      depth + 1);
+}
+
+template <typename Index>
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t
+_hashed_depth(const Index *buckets, std::size_t size, std::size_t max_length,
+              const char *name, std::size_t length,
+              optional<std::size_t> index)
+{
+    return
+        length > max_length ? 0 :
+        _bucket_depth(buckets, size,
+                      buckets[2 * _name_hash(name, length, size)], index);
+}
+
+#endif // #ifdef BETTER_ENUMS_CONVERSION_HOOK
+
+// Fills in the table described above and the name lengths, and returns the
+// length of the longest name. In C++98, this is called by initialize(). In
+// C++11 and later, it is called by the constructor of _hash_table.
+template <typename Index>
+BETTER_ENUMS_RELAXED_CONSTEXPR_ inline std::size_t
+_fill_buckets(const char * const *names, std::size_t *lengths, Index *buckets,
+              std::size_t size)
+{
+    std::size_t     max_length = 0;
+
+    for (std::size_t index = 0; index < size; ++index)
+        buckets[2 * index] = static_cast<Index>(size);
+
+    for (std::size_t index = size; index > 0; --index) {
+        std::size_t length = _constant_length(names[index - 1]);
+        std::size_t bucket = _name_hash(names[index - 1], length, size);
+
+        lengths[index - 1] = length;
+
+        buckets[2 * (index - 1) + 1] = buckets[2 * bucket];
+        buckets[2 * bucket] = static_cast<Index>(index - 1);
+
+        if (length > max_length)
+            max_length = length;
+    }
+
+    return max_length;
 }
 
-BETTER_ENUMS_CONSTEXPR_ inline bool
-_names_match_nocase(const char *stringizedName, const char *referenceName,
-                    std::size_t index = 0)
+// Filling in the table at compile time costs every enum that is declared,
+// whether its names are looked up or not, so constant expressions use a linear
+// scan instead.
+BETTER_ENUMS_CONSTEXPR_ inline optional<std::size_t>
+_linear_find(const char * const *names, std::size_t size, const char *name,
+             std::size_t length, bool nocase, std::size_t index = 0)
+{
+    return
+        index == size ? optional<std::size_t>() :
+        (nocase ? _names_match_nocase(names[index], name, length) :
+                  _names_match(names[index], name, length)) ?
+            optional<std::size_t>(index) :
+        _linear_find(names, size, name, length, nocase, index + 1);
+}
+
+#ifdef BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
+
+// The table is shared by all enums with the same size and index type, so that
+// each enum only instantiates the function that holds its own table. The
+// constructor is not constexpr, so that the compiler never builds a table at
+// compile time.
+template <typename Index, std::size_t Size>
+struct _hash_table {
+    Index           buckets[2 * Size];
+    std::size_t     lengths[Size];
+    std::size_t     max_length;
+
+    // The members are initialized in order, so the arrays are ready for
+    // _fill_buckets by the time max_length is initialized.
+    explicit _hash_table(const char * const *names) :
+        buckets(), lengths(),
+        max_length(_fill_buckets(names, lengths, buckets, Size)) { }
+
+    std::size_t bounded(const char *name, std::size_t length) const
+    {
+        return
+            length == _null_terminated ?
+                _bounded_length(name, max_length + 1) : length;
+    }
+
+    optional<std::size_t> find(const char * const *names, const char *name,
+                               std::size_t length, bool nocase) const
+    {
+        return
+            _hashed_find(names, lengths, buckets, Size, max_length, name,
+                         bounded(name, length), nocase);
+    }
+
+#ifdef BETTER_ENUMS_CONVERSION_HOOK
+    std::size_t depth(const char *name, std::size_t length,
+                      optional<std::size_t> index) const
+    {
+        return
+            _hashed_depth(buckets, Size, max_length, name,
+                          bounded(name, length), index);
+    }
+#endif
+};
+
+// The run-time table of each enum is a function-local static, so it is built by
+// the first lookup, and its initialization is thread-safe.
+template <typename Enum>
+const _hash_table<typename _index_type<Enum::_size_constant>::type,
+                  Enum::_size_constant>&
+_name_table(const char * const *names)
+{
+    static const _hash_table<typename _index_type<Enum::_size_constant>::type,
+                             Enum::_size_constant>  table(names);
+    return table;
+}
+
+#endif // #ifdef BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
+
+
+
+// The size of the buffer that operator >> reads a token into in C++11: the
+// exact length of the longest name. The size depends on Char, so that the
+// length is only computed for enums that are actually read from streams.
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+template <typename Enum, typename Char>
+constexpr std::size_t _token_size()
 {
-    return
-        _ends_name(stringizedName[index]) ? referenceName[index] == '\0' :
-        referenceName[index] == '\0' ? false :
-        _to_lower_ascii(stringizedName[index]) !=
-            _to_lower_ascii(referenceName[index]) ? false :
-        _names_match_nocase(stringizedName, referenceName, index + 1);
+    return max_name_length<Enum>();
 }
 
-inline void _trim_names(const char * const *raw_names,
-                        const char **trimmed_names,
-                        char *storage, std::size_t count)
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+// Stream input. Reads the next whitespace-delimited token of stream into
+// buffer, which has room for size characters, and returns its length. Each
+// character is converted to char by the stream's narrow(), so that wide streams
+// can be matched against the names directly, and characters with no narrow
+// equivalent become '\0', which is not part of any name. Reading stops as soon
+// as the token turns out to be longer than size, so that input which cannot be
+// a name is rejected without being read to its end. In that case, and if there
+// is no token at all, failbit is set.
+template <typename Char, typename Traits>
+std::size_t _read_token(std::basic_istream<Char, Traits> &stream, char *buffer,
+                        std::size_t size)
 {
-    std::size_t     offset = 0;
+    typedef std::basic_istream<Char, Traits>    istream;
+    typedef typename Traits::int_type           int_type;
 
-    for (std::size_t index = 0; index < count; ++index) {
-        trimmed_names[index] = storage + offset;
+    typename istream::sentry    sentry(stream);
+    std::size_t                 length = 0;
 
-        std::size_t trimmed_length =
-            std::strcspn(raw_names[index], _name_enders);
-        storage[offset + trimmed_length] = '\0';
+    if (!sentry)
+        return 0;
 
-        std::size_t raw_length = std::strlen(raw_names[index]);
-        offset += raw_length + 1;
+    std::basic_streambuf<Char, Traits>  *input = stream.rdbuf();
+    int_type                            next = input->sgetc();
+
+    while (!Traits::eq_int_type(next, Traits::eof())) {
+        char    c = stream.narrow(Traits::to_char_type(next), '\0');
+
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' ||
+            c == '\r') {
+
+            break;
+        }
+
+        if (length == size) {
+            stream.width(0);
+            stream.setstate(istream::failbit);
+            return 0;
+        }
+
+        buffer[length++] = c;
+        next = input->snextc();
     }
+
+    stream.width(0);
+
+    if (Traits::eq_int_type(next, Traits::eof()))
+        stream.setstate(istream::eofbit);
+    if (length == 0)
+        stream.setstate(istream::failbit);
+
+    return length;
 }
 
 
@@ -536,6 +1858,8 @@ struct _initialize_at_program_start {
 
 } // namespace better_enums
 
+#endif // #ifndef BETTER_ENUMS_MODULE_IMPORTED
+
 
 
 // Array generation macros.
@@ -552,25 +1876,167 @@ struct _initialize_at_program_start {
 
 #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
 
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+
+#define BETTER_ENUMS_DENSE_TABLE(Enum)                                         \
+    BETTER_ENUMS_DATA_ constexpr ::better_enums::_value_shape  _shape =        \
+        ::better_enums::_shape(_value_array, Enum::_size_constant);            \
+                                                                               \
+    typedef ::better_enums::_index_type<Enum::_size_constant>::type            \
+                                _dense_index;                                  \
+    BETTER_ENUMS_DATA_ constexpr                                               \
+    ::better_enums::_value_table<                                              \
+        Enum::_integral, _dense_index,                                         \
+        _shape == ::better_enums::_shape_dense ? Enum::_size_constant : 0>     \
+                                _dense_table(_value_array);
+
+#define BETTER_ENUMS_FROM_VALUE(Enum, value)                                   \
+    BETTER_ENUMS_NS(Enum)::_shape == ::better_enums::_shape_sequential ?       \
+        ::better_enums::_sequential_find(                                      \
+            _size(), BETTER_ENUMS_NS(Enum)::_value_array[0]._value, value) :   \
+    BETTER_ENUMS_NS(Enum)::_shape == ::better_enums::_shape_dense ?            \
+        ::better_enums::_dense_find(BETTER_ENUMS_NS(Enum)::_dense_table.slots, \
+                                    _size(),                                   \
+                                    BETTER_ENUMS_NS(Enum)::_dense_table.base,  \
+                                    value) :                                   \
+        _from_value_loop(value)
+
+#define BETTER_ENUMS_VALUE_DEPTH(Enum, index)                                  \
+    (BETTER_ENUMS_NS(Enum)::_shape != ::better_enums::_shape_sparse ?          \
+        1 : ::better_enums::_linear_depth(_size(), index))
+
+#else
+
+#define BETTER_ENUMS_DENSE_TABLE(Enum)                                         \
+    BETTER_ENUMS_DATA_ constexpr bool  _sequential =                           \
+        ::better_enums::_sequential(_value_array, 0, Enum::_size_constant);
+
+#define BETTER_ENUMS_FROM_VALUE(Enum, value)                                   \
+    BETTER_ENUMS_NS(Enum)::_sequential ?                                       \
+        ::better_enums::_sequential_find(                                      \
+            _size(), BETTER_ENUMS_NS(Enum)::_value_array[0]._value, value) :   \
+        _from_value_loop(value)
 
+#define BETTER_ENUMS_VALUE_DEPTH(Enum, index)                                  \
+    (BETTER_ENUMS_NS(Enum)::_sequential ?                                      \
+        1 : ::better_enums::_linear_depth(_size(), index))
 
-#define BETTER_ENUMS_SELECT_SINGLE_CHARACTER(from, from_length, index)         \
-    ::better_enums::_select(from, from_length, index),
+#endif // #ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
 
-#define BETTER_ENUMS_SELECT_CHARACTERS(from, from_length)                      \
-    BETTER_ENUMS_ITERATE(                                                      \
-        BETTER_ENUMS_SELECT_SINGLE_CHARACTER, from, from_length)
+#define BETTER_ENUMS_INITIALIZE_NAME_TABLE(Enum)
 
+#define BETTER_ENUMS_NAME_TABLE(Enum)
 
+#ifdef BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
 
+#define BETTER_ENUMS_FROM_NAME(Enum, name, length, nocase)                     \
+    (BETTER_ENUMS_IS_CONSTANT_EVALUATED() ?                                    \
+        ::better_enums::_linear_find(BETTER_ENUMS_NS(Enum)::_raw_names(),      \
+                                     _size(), name, length, nocase) :          \
+        ::better_enums::_name_table<Enum>(                                     \
+            BETTER_ENUMS_NS(Enum)::_raw_names()).find(                         \
+                BETTER_ENUMS_NS(Enum)::_raw_names(), name, length, nocase))
+
+#define BETTER_ENUMS_NAME_DEPTH(Enum, name, length, index)                     \
+    (BETTER_ENUMS_IS_CONSTANT_EVALUATED() ?                                    \
+        ::better_enums::_linear_depth(_size(), index) :                        \
+        ::better_enums::_name_table<Enum>(                                     \
+            BETTER_ENUMS_NS(Enum)::_raw_names()).depth(name, length, index))
+
+#else
+
+#define BETTER_ENUMS_FROM_NAME(Enum, name, length, nocase)                     \
+    ::better_enums::_linear_find(BETTER_ENUMS_NS(Enum)::_raw_names(), _size(), \
+                                 name, length, nocase)
+
+#define BETTER_ENUMS_NAME_DEPTH(Enum, name, length, index)                     \
+    (static_cast<void>(name), static_cast<void>(length),                       \
+     ::better_enums::_linear_depth(_size(), index))
+
+#endif // #ifdef BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
+
+#else
+
+#define BETTER_ENUMS_DENSE_TABLE(Enum)
+
+#define BETTER_ENUMS_FROM_VALUE(Enum, value)                                   \
+    _from_value_loop(value)
+
+#define BETTER_ENUMS_VALUE_DEPTH(Enum, index)                                  \
+    ::better_enums::_linear_depth(_size(), index)
+
+// In C++98, the name table and the length of the longest name are filled in by
+// initialize(). Null-terminated names are then measured only up to one past
+// that length.
+#define BETTER_ENUMS_NAME_TABLE(Enum)                                          \
+    typedef ::better_enums::_index_type<Enum::_size_constant>::type            \
+                                _name_index;                                   \
+                                                                               \
+    inline _name_index* _name_buckets()                                        \
+    {                                                                          \
+        static _name_index  value[2 * Enum::_size_constant];                   \
+        return value;                                                          \
+    }                                                                          \
+                                                                               \
+    inline std::size_t& _name_max_length()                                     \
+    {                                                                          \
+        static std::size_t  value = 0;                                         \
+        return value;                                                          \
+    }
+
+#define BETTER_ENUMS_INITIALIZE_NAME_TABLE(Enum)                               \
+            (BETTER_ENUMS_NS(Enum)::_name_max_length() =                       \
+                ::better_enums::_fill_buckets(                                 \
+                    BETTER_ENUMS_NS(Enum)::_raw_names(),                       \
+                    BETTER_ENUMS_NS(Enum)::_name_lengths(),                    \
+                    BETTER_ENUMS_NS(Enum)::_name_buckets(), _size())),
+
+#define BETTER_ENUMS_FROM_NAME(Enum, name, length, nocase)                     \
+    (static_cast<void>(initialize()),                                          \
+        ::better_enums::_hashed_find(                                          \
+            BETTER_ENUMS_NS(Enum)::_raw_names(),                               \
+            BETTER_ENUMS_NS(Enum)::_name_lengths(),                            \
+            BETTER_ENUMS_NS(Enum)::_name_buckets(), _size(),                   \
+            BETTER_ENUMS_NS(Enum)::_name_max_length(), name,                   \
+            length == ::better_enums::_null_terminated ?                       \
+                ::better_enums::_bounded_length(                               \
+                    name, BETTER_ENUMS_NS(Enum)::_name_max_length() + 1) :     \
+                length,                                                        \
+            nocase))
+
+#define BETTER_ENUMS_NAME_DEPTH(Enum, name, length, index)                     \
+    ::better_enums::_hashed_depth(                                             \
+        BETTER_ENUMS_NS(Enum)::_name_buckets(), _size(),                       \
+        BETTER_ENUMS_NS(Enum)::_name_max_length(), name,                       \
+        length == ::better_enums::_null_terminated ?                           \
+            ::better_enums::_bounded_length(                                   \
+                name, BETTER_ENUMS_NS(Enum)::_name_max_length() + 1) :         \
+            length,                                                            \
+        index)
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+// Names without an initializer are used as they are, so their copies are left
+// empty.
 #define BETTER_ENUMS_TRIM_SINGLE_STRING(ignored, index, expression)            \
-constexpr std::size_t   _length_ ## index =                                    \
+BETTER_ENUMS_DATA_ constexpr std::size_t    _length_ ## index =                \
     ::better_enums::_constant_length(#expression);                             \
-constexpr const char    _trimmed_ ## index [] =                                \
-    { BETTER_ENUMS_SELECT_CHARACTERS(#expression, _length_ ## index) };        \
-constexpr const char    *_final_ ## index =                                    \
-    ::better_enums::_has_initializer(#expression) ?                            \
-        _trimmed_ ## index : #expression;
+BETTER_ENUMS_DATA_ constexpr bool           _initialized_ ## index =           \
+    ::better_enums::_has_initializer(#expression);                             \
+BETTER_ENUMS_DATA_ constexpr ::better_enums::_trimmed_name<                    \
+    _initialized_ ## index ? _length_ ## index : 0>                            \
+                                            _trimmed_ ## index(                \
+    #expression,                                                               \
+    ::better_enums::_make_indices<                                             \
+        _initialized_ ## index ? _length_ ## index : 0>::type());              \
+BETTER_ENUMS_DATA_ constexpr const char     *_final_ ## index =                \
+    _initialized_ ## index ? _trimmed_ ## index.characters : #expression;
 
 #define BETTER_ENUMS_TRIM_STRINGS(...)                                         \
     BETTER_ENUMS_ID(                                                           \
@@ -587,6 +2053,14 @@ constexpr const char    *_final_ ## index =                                    \
         BETTER_ENUMS_PP_MAP(                                                   \
             BETTER_ENUMS_REFER_TO_SINGLE_STRING, ignored, __VA_ARGS__))
 
+#define BETTER_ENUMS_REFER_TO_SINGLE_LENGTH(ignored, index, expression)        \
+    _length_ ## index,
+
+#define BETTER_ENUMS_REFER_TO_LENGTHS(...)                                     \
+    BETTER_ENUMS_ID(                                                           \
+        BETTER_ENUMS_PP_MAP(                                                   \
+            BETTER_ENUMS_REFER_TO_SINGLE_LENGTH, ignored, __VA_ARGS__))
+
 
 
 #endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
@@ -610,6 +2084,187 @@ constexpr const char    *_final_ ## index =                                    \
 
 
 
+// The longest name is bounded by the longest constant, including any
+// initializer. Its size is the size of a union of character arrays, one per
+// stringized constant. C++98 has no way to find the end of a name at compile
+// time, and in C++11, finding the ends of all the names would cost every enum
+// compile time, whether the length is used or not. The exact length is computed
+// by max_name_length, only where it is used.
+#define BETTER_ENUMS_NAME_LENGTH_SINGLE(ignored, index, expression)            \
+    char _ ## index[sizeof(#expression)];
+
+#define BETTER_ENUMS_NAME_LENGTHS(...)                                         \
+    union _constant_sizes {                                                    \
+        BETTER_ENUMS_ID(                                                       \
+            BETTER_ENUMS_PP_MAP(                                               \
+                BETTER_ENUMS_NAME_LENGTH_SINGLE, ignored, __VA_ARGS__))        \
+    };
+
+#define BETTER_ENUMS_MAX_NAME_LENGTH(Enum)                                     \
+    (sizeof(BETTER_ENUMS_NS(Enum)::_constant_sizes) - 1)
+
+// Generated enums know the exact lengths, and keep the union only so that
+// BETTER_ENUMS_MAX_NAME_LENGTH works the same way.
+#define BETTER_ENUMS_GENERATED_NAME_LENGTHS(Enum, ...)                         \
+    BETTER_ENUMS_DATA_ BETTER_ENUMS_CONSTEXPR_ const std::size_t               \
+                                _constant_lengths[] =                          \
+        { BETTER_ENUMS_GENERATED_TABLE(Enum, lengths) };                       \
+                                                                               \
+    union _constant_sizes {                                                    \
+        char _longest[BETTER_ENUMS_GENERATED_TABLE(Enum, max_length) + 1];     \
+    };
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+#define BETTER_ENUMS_TOKEN_SIZE(Enum, Char)                                    \
+    ::better_enums::_token_size<Enum, Char>()
+
+#else
+
+#define BETTER_ENUMS_TOKEN_SIZE(Enum, Char)                                    \
+    Enum::_max_name_length_constant
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+// Conversion hook. _from_value and _from_name pass the index they found through
+// _report_value and _report_name, which report the lookup and return the index.
+// Without the hook, they are not declared, and the index is returned directly.
+#ifdef BETTER_ENUMS_CONVERSION_HOOK
+
+#define BETTER_ENUMS_DECLARE_REPORT                                            \
+    BETTER_ENUMS_CONSTEXPR_ static _optional_index                             \
+    _report_value(_optional_index index);                                      \
+    BETTER_ENUMS_CONSTEXPR_ static _optional_index                             \
+    _report_name(const char *name, std::size_t length, bool nocase,            \
+                 _optional_index index);
+
+#define BETTER_ENUMS_DEFINE_REPORT(Enum, Constants)                            \
+    BETTER_ENUMS_CONSTEXPR_ inline Enum::_optional_index                       \
+    Enum::_report_value(_optional_index index)                                 \
+    {                                                                          \
+        return                                                                 \
+            static_cast<void>(                                                 \
+                ::better_enums::_report(                                       \
+                    #Enum, ::better_enums::conversion_from_value, index,       \
+                    BETTER_ENUMS_VALUE_DEPTH(Enum, index))),                   \
+            index;                                                             \
+    }                                                                          \
+                                                                               \
+    BETTER_ENUMS_CONSTEXPR_ inline Enum::_optional_index                       \
+    Enum::_report_name(const char *name, std::size_t length, bool nocase,      \
+                       _optional_index index)                                  \
+    {                                                                          \
+        return                                                                 \
+            static_cast<void>(                                                 \
+                ::better_enums::_report(                                       \
+                    #Enum,                                                     \
+                    nocase ?                                                   \
+                        ::better_enums::conversion_from_name_nocase :          \
+                        ::better_enums::conversion_from_name,                  \
+                    index, Constants(NAME_DEPTH, Enum, name, length, index))), \
+            index;                                                             \
+    }
+
+#define BETTER_ENUMS_REPORT_VALUE(lookup)                                      \
+    _report_value(lookup)
+
+#define BETTER_ENUMS_REPORT_NAME(name, length, nocase, lookup)                 \
+    _report_name(name, length, nocase, lookup)
+
+#define BETTER_ENUMS_REPORT_INITIALIZE(Enum)                                   \
+    ::better_enums::_report(#Enum, ::better_enums::conversion_initialize,      \
+                            true, _size()),
+
+#else
+
+#define BETTER_ENUMS_DECLARE_REPORT
+#define BETTER_ENUMS_DEFINE_REPORT(Enum, Constants)
+#define BETTER_ENUMS_REPORT_VALUE(lookup) lookup
+#define BETTER_ENUMS_REPORT_NAME(name, length, nocase, lookup) lookup
+#define BETTER_ENUMS_REPORT_INITIALIZE(Enum)
+
+#endif // #ifdef BETTER_ENUMS_CONVERSION_HOOK
+
+
+
+// Sources of the constants. BETTER_ENUMS_TYPE takes one of these as Constants,
+// and expands Constants(Part, Enum, ...) for each part of an enum that is
+// computed from its constants. BETTER_ENUMS_DECLARED computes each part from
+// the constants as they are declared, with the macros above.
+// BETTER_ENUMS_GENERATED reads the parts from the macros written by
+// script/make_enums.py, which has already trimmed the names, measured them, and
+// filled in the name hash table, so that none of that is left to the compiler.
+// The generated macros are named better_enums_generated_<Enum>_<part>.
+
+#define BETTER_ENUMS_DECLARED(Part, Enum, ...)                                 \
+    BETTER_ENUMS_ID(BETTER_ENUMS_DECLARED_ ## Part(Enum, __VA_ARGS__))
+
+#define BETTER_ENUMS_DECLARED_COUNT(Enum, ...)                                 \
+    BETTER_ENUMS_ID(BETTER_ENUMS_PP_COUNT(__VA_ARGS__))
+
+#define BETTER_ENUMS_DECLARED_VALUES(Enum, ...)                                \
+    BETTER_ENUMS_ID(BETTER_ENUMS_EAT_ASSIGN(Enum, __VA_ARGS__))
+
+#define BETTER_ENUMS_DECLARED_NAME_LENGTHS(Enum, ...)                          \
+    BETTER_ENUMS_ID(BETTER_ENUMS_NAME_LENGTHS(__VA_ARGS__))
+
+#define BETTER_ENUMS_DECLARED_NAME_TABLE(Enum, ...)                            \
+    BETTER_ENUMS_NAME_TABLE(Enum)
+
+#define BETTER_ENUMS_DECLARED_FROM_NAME(Enum, name, length, nocase)            \
+    BETTER_ENUMS_FROM_NAME(Enum, name, length, nocase)
+
+#define BETTER_ENUMS_DECLARED_NAME_DEPTH(Enum, name, length, index)            \
+    BETTER_ENUMS_NAME_DEPTH(Enum, name, length, index)
+
+#define BETTER_ENUMS_GENERATED(Part, Enum, ...)                                \
+    BETTER_ENUMS_ID(BETTER_ENUMS_GENERATED_ ## Part(Enum, __VA_ARGS__))
+
+#define BETTER_ENUMS_GENERATED_TABLE(Enum, part)                               \
+    better_enums_generated_ ## Enum ## _ ## part
+
+#define BETTER_ENUMS_GENERATED_COUNT(Enum, ...)                                \
+    BETTER_ENUMS_GENERATED_TABLE(Enum, count)
+
+#define BETTER_ENUMS_GENERATED_VALUES(Enum, ...)                               \
+    BETTER_ENUMS_GENERATED_TABLE(Enum, values)
+
+#define BETTER_ENUMS_GENERATED_NAME_TABLE(Enum, ...)                           \
+    typedef ::better_enums::_index_type<Enum::_size_constant>::type            \
+                                _name_index;                                   \
+    BETTER_ENUMS_DATA_ BETTER_ENUMS_CONSTEXPR_ const _name_index               \
+                                _name_buckets[] =                              \
+        { BETTER_ENUMS_GENERATED_TABLE(Enum, buckets) };
+
+// The same lookup as BETTER_ENUMS_FROM_NAME with relaxed constexpr, in every
+// mode, since the table is already filled in.
+#define BETTER_ENUMS_GENERATED_FROM_NAME(Enum, name, length, nocase)           \
+    ::better_enums::_hashed_find(                                              \
+        BETTER_ENUMS_NS(Enum)::_raw_names(),                                   \
+        BETTER_ENUMS_NS(Enum)::_constant_lengths,                              \
+        BETTER_ENUMS_NS(Enum)::_name_buckets, _size(),                         \
+        _max_name_length_constant, name,                                       \
+        length == ::better_enums::_null_terminated ?                           \
+            ::better_enums::_bounded_length(                                   \
+                name, _max_name_length_constant + 1) :                         \
+            length,                                                            \
+        nocase)
+
+#define BETTER_ENUMS_GENERATED_NAME_DEPTH(Enum, name, length, index)           \
+    ::better_enums::_hashed_depth(                                             \
+        BETTER_ENUMS_NS(Enum)::_name_buckets, _size(),                         \
+        _max_name_length_constant, name,                                       \
+        length == ::better_enums::_null_terminated ?                           \
+            ::better_enums::_bounded_length(                                   \
+                name, _max_name_length_constant + 1) :                         \
+            length,                                                            \
+        index)
+
+
+
+
 // The enums proper.
 
 #define BETTER_ENUMS_NS(EnumType)  better_enums_data_ ## EnumType
@@ -633,11 +2288,12 @@ constexpr const char    *_final_ ## index =                                    \
 #define BETTER_ENUMS_TYPE(SetUnderlyingType, SwitchType, GenerateSwitchType,   \
                           GenerateStrings, ToStringConstexpr,                  \
                           DeclareInitialize, DefineInitialize, CallInitialize, \
-                          Enum, Underlying, ...)                               \
+                          Constants, Enum, Underlying, ...)                    \
                                                                                \
 namespace better_enums_data_ ## Enum {                                         \
                                                                                \
 BETTER_ENUMS_ID(GenerateSwitchType(Underlying, __VA_ARGS__))                   \
+BETTER_ENUMS_ID(Constants(NAME_LENGTHS, Enum, __VA_ARGS__))                    \
                                                                                \
 }                                                                              \
                                                                                \
@@ -679,21 +2335,56 @@ class BETTER_ENUMS_CLASS_ATTRIBUTE Enum {
     _from_index_nothrow(std::size_t value);                                    \
                                                                                \
     ToStringConstexpr const char* _to_string() const;                          \
+    ToStringConstexpr std::size_t _name_length() const;                        \
+    char* _write_to(char *first, char *last) const;                            \
+    BETTER_ENUMS_IF_STRING_VIEW(                                               \
+    ToStringConstexpr std::string_view _to_string_view() const;                \
+    )                                                                          \
     BETTER_ENUMS_IF_EXCEPTIONS(                                                \
     BETTER_ENUMS_CONSTEXPR_ static Enum _from_string(const char *name);        \
+    BETTER_ENUMS_CONSTEXPR_ static Enum                                        \
+    _from_string(const char *name, std::size_t length);                        \
     )                                                                          \
     BETTER_ENUMS_CONSTEXPR_ static _optional                                   \
     _from_string_nothrow(const char *name);                                    \
+    BETTER_ENUMS_CONSTEXPR_ static _optional                                   \
+    _from_string_nothrow(const char *name, std::size_t length);                \
                                                                                \
     BETTER_ENUMS_IF_EXCEPTIONS(                                                \
     BETTER_ENUMS_CONSTEXPR_ static Enum _from_string_nocase(const char *name); \
+    BETTER_ENUMS_CONSTEXPR_ static Enum                                        \
+    _from_string_nocase(const char *name, std::size_t length);                 \
     )                                                                          \
     BETTER_ENUMS_CONSTEXPR_ static _optional                                   \
     _from_string_nocase_nothrow(const char *name);                             \
+    BETTER_ENUMS_CONSTEXPR_ static _optional                                   \
+    _from_string_nocase_nothrow(const char *name, std::size_t length);         \
                                                                                \
     BETTER_ENUMS_CONSTEXPR_ static bool _is_valid(_integral value);            \
     BETTER_ENUMS_CONSTEXPR_ static bool _is_valid(const char *name);           \
+    BETTER_ENUMS_CONSTEXPR_ static bool                                        \
+    _is_valid(const char *name, std::size_t length);                           \
     BETTER_ENUMS_CONSTEXPR_ static bool _is_valid_nocase(const char *name);    \
+    BETTER_ENUMS_CONSTEXPR_ static bool                                        \
+    _is_valid_nocase(const char *name, std::size_t length);                    \
+                                                                               \
+    BETTER_ENUMS_IF_STRING_VIEW(                                               \
+    BETTER_ENUMS_IF_EXCEPTIONS(                                                \
+    constexpr static Enum _from_string(std::string_view name)                  \
+        { return _from_string(name.data(), name.size()); }                     \
+    constexpr static Enum _from_string_nocase(std::string_view name)           \
+        { return _from_string_nocase(name.data(), name.size()); }              \
+    )                                                                          \
+    constexpr static _optional _from_string_nothrow(std::string_view name)     \
+        { return _from_string_nothrow(name.data(), name.size()); }             \
+    constexpr static _optional                                                 \
+    _from_string_nocase_nothrow(std::string_view name)                         \
+        { return _from_string_nocase_nothrow(name.data(), name.size()); }      \
+    constexpr static bool _is_valid(std::string_view name)                     \
+        { return _is_valid(name.data(), name.size()); }                        \
+    constexpr static bool _is_valid_nocase(std::string_view name)              \
+        { return _is_valid_nocase(name.data(), name.size()); }                 \
+    )                                                                          \
                                                                                \
     typedef ::better_enums::_iterable<Enum>             _value_iterable;       \
     typedef ::better_enums::_iterable<const char*>      _name_iterable;        \
@@ -702,13 +2393,22 @@ class BETTER_ENUMS_CLASS_ATTRIBUTE Enum {
     typedef _name_iterable::iterator                    _name_iterator;        \
                                                                                \
     BETTER_ENUMS_CONSTEXPR_ static const std::size_t _size_constant =          \
-        BETTER_ENUMS_ID(BETTER_ENUMS_PP_COUNT(__VA_ARGS__));                   \
+        BETTER_ENUMS_ID(Constants(COUNT, Enum, __VA_ARGS__));                  \
     BETTER_ENUMS_CONSTEXPR_ static std::size_t _size()                         \
         { return _size_constant; }                                             \
                                                                                \
+    BETTER_ENUMS_CONSTEXPR_ static const std::size_t                           \
+        _max_name_length_constant = BETTER_ENUMS_MAX_NAME_LENGTH(Enum);        \
+    BETTER_ENUMS_CONSTEXPR_ static std::size_t _max_name_length()              \
+        { return _max_name_length_constant; }                                  \
+    BETTER_ENUMS_IF_CONSTEXPR(                                                 \
+    constexpr static const char* _declared_name(std::size_t index);            \
+    )                                                                          \
+                                                                               \
     BETTER_ENUMS_CONSTEXPR_ static const char* _name();                        \
     BETTER_ENUMS_CONSTEXPR_ static _value_iterable _values();                  \
     ToStringConstexpr static _name_iterable _names();                          \
+    ToStringConstexpr static std::size_t _name_length(std::size_t index);      \
                                                                                \
     _integral      _value;                                                     \
                                                                                \
@@ -721,30 +2421,34 @@ class BETTER_ENUMS_CLASS_ATTRIBUTE Enum {
     DeclareInitialize                                                          \
                                                                                \
     BETTER_ENUMS_CONSTEXPR_ static _optional_index                             \
-    _from_value_loop(_integral value, std::size_t index = 0);                  \
+    _from_value(_integral value);                                              \
     BETTER_ENUMS_CONSTEXPR_ static _optional_index                             \
-    _from_string_loop(const char *name, std::size_t index = 0);                \
+    _from_value_loop(_integral value, std::size_t index = 0);                  \
     BETTER_ENUMS_CONSTEXPR_ static _optional_index                             \
-    _from_string_nocase_loop(const char *name, std::size_t index = 0);         \
+    _from_name(const char *name, std::size_t length, bool nocase);             \
+    BETTER_ENUMS_DECLARE_REPORT                                                \
                                                                                \
     friend struct ::better_enums::_initialize_at_program_start<Enum>;          \
 };                                                                             \
                                                                                \
 namespace better_enums_data_ ## Enum {                                         \
                                                                                \
-static ::better_enums::_initialize_at_program_start<Enum>                      \
-                                                _force_initialization;         \
+BETTER_ENUMS_FORCE_INITIALIZATION(Enum)                                        \
                                                                                \
 enum _putNamesInThisScopeAlso { __VA_ARGS__ };                                 \
                                                                                \
 BETTER_ENUMS_IGNORE_OLD_CAST_HEADER                                            \
 BETTER_ENUMS_IGNORE_OLD_CAST_BEGIN                                             \
-BETTER_ENUMS_CONSTEXPR_ const Enum      _value_array[] =                       \
-    { BETTER_ENUMS_ID(BETTER_ENUMS_EAT_ASSIGN(Enum, __VA_ARGS__)) };           \
+BETTER_ENUMS_DATA_ BETTER_ENUMS_CONSTEXPR_ const Enum  _value_array[] =        \
+    { BETTER_ENUMS_ID(Constants(VALUES, Enum, __VA_ARGS__)) };                 \
 BETTER_ENUMS_IGNORE_OLD_CAST_END                                               \
                                                                                \
 BETTER_ENUMS_ID(GenerateStrings(Enum, __VA_ARGS__))                            \
                                                                                \
+BETTER_ENUMS_DENSE_TABLE(Enum)                                                 \
+                                                                               \
+BETTER_ENUMS_ID(Constants(NAME_TABLE, Enum, __VA_ARGS__))                      \
+                                                                               \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_IGNORE_ATTRIBUTES_HEADER                                          \
@@ -769,27 +2473,22 @@ Enum::_from_value_loop(Enum::_integral value, std::size_t index)               \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline Enum::_optional_index                           \
-Enum::_from_string_loop(const char *name, std::size_t index)                   \
+Enum::_from_value(Enum::_integral value)                                       \
 {                                                                              \
-    return                                                                     \
-        index == _size() ? _optional_index() :                                 \
-        ::better_enums::_names_match(                                          \
-            BETTER_ENUMS_NS(Enum)::_raw_names()[index], name) ?                \
-            _optional_index(index) :                                           \
-            _from_string_loop(name, index + 1);                                \
+    return BETTER_ENUMS_REPORT_VALUE(BETTER_ENUMS_FROM_VALUE(Enum, value));    \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline Enum::_optional_index                           \
-Enum::_from_string_nocase_loop(const char *name, std::size_t index)            \
+Enum::_from_name(const char *name, std::size_t length, bool nocase)            \
 {                                                                              \
     return                                                                     \
-        index == _size() ? _optional_index() :                                 \
-            ::better_enums::_names_match_nocase(                               \
-                BETTER_ENUMS_NS(Enum)::_raw_names()[index], name) ?            \
-                    _optional_index(index) :                                   \
-                    _from_string_nocase_loop(name, index + 1);                 \
+        BETTER_ENUMS_REPORT_NAME(                                              \
+            name, length, nocase,                                              \
+            Constants(FROM_NAME, Enum, name, length, nocase));                 \
 }                                                                              \
                                                                                \
+BETTER_ENUMS_DEFINE_REPORT(Enum, Constants)                                    \
+                                                                               \
 BETTER_ENUMS_CONSTEXPR_ inline Enum::_integral Enum::_to_integral() const      \
 {                                                                              \
     return _integral(_value);                                                  \
@@ -797,7 +2496,7 @@ BETTER_ENUMS_CONSTEXPR_ inline Enum::_integral Enum::_to_integral() const      \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline std::size_t Enum::_to_index() const             \
 {                                                                              \
-    return *_from_value_loop(_value);                                          \
+    return *_from_value(_value);                                               \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline Enum                                            \
@@ -836,7 +2535,7 @@ Enum::_from_integral_nothrow(_integral value)                                  \
 {                                                                              \
     return                                                                     \
         ::better_enums::_map_index<Enum>(BETTER_ENUMS_NS(Enum)::_value_array,  \
-                                         _from_value_loop(value));             \
+                                         _from_value(value));                  \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_IF_EXCEPTIONS(                                                    \
@@ -854,15 +2553,58 @@ ToStringConstexpr inline const char* Enum::_to_string() const                  \
         ::better_enums::_or_null(                                              \
             ::better_enums::_map_index<const char*>(                           \
                 BETTER_ENUMS_NS(Enum)::_name_array(),                          \
-                _from_value_loop(CallInitialize(_value))));                    \
+                _from_value(CallInitialize(_value))));                         \
+}                                                                              \
+                                                                               \
+ToStringConstexpr inline std::size_t Enum::_name_length() const                \
+{                                                                              \
+    return                                                                     \
+        ::better_enums::_map_length(BETTER_ENUMS_NS(Enum)::_name_lengths(),    \
+                                    _from_value(CallInitialize(_value)));      \
+}                                                                              \
+                                                                               \
+BETTER_ENUMS_IF_CONSTEXPR(                                                     \
+constexpr inline const char* Enum::_declared_name(std::size_t index)           \
+{                                                                              \
+    return BETTER_ENUMS_NS(Enum)::_raw_names()[index];                         \
+}                                                                              \
+)                                                                              \
+                                                                               \
+inline char* Enum::_write_to(char *first, char *last) const                    \
+{                                                                              \
+    _optional_index index = _from_value(CallInitialize(_value));               \
+                                                                               \
+    return                                                                     \
+        index ?                                                                \
+            ::better_enums::_write_chars(                                      \
+                BETTER_ENUMS_NS(Enum)::_name_array()[*index],                  \
+                BETTER_ENUMS_NS(Enum)::_name_lengths()[*index], first, last) : \
+            ::better_enums::_write_integral(_value, first, last);              \
+}                                                                              \
+                                                                               \
+BETTER_ENUMS_IF_STRING_VIEW(                                                   \
+ToStringConstexpr inline std::string_view Enum::_to_string_view() const        \
+{                                                                              \
+    return                                                                     \
+        ::better_enums::_map_name(BETTER_ENUMS_NS(Enum)::_name_array(),        \
+                                  BETTER_ENUMS_NS(Enum)::_name_lengths(),      \
+                                  _from_value(CallInitialize(_value)));        \
 }                                                                              \
+)                                                                              \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline Enum::_optional                                 \
 Enum::_from_string_nothrow(const char *name)                                   \
+{                                                                              \
+    return _from_string_nothrow(name, ::better_enums::_null_terminated);       \
+}                                                                              \
+                                                                               \
+BETTER_ENUMS_CONSTEXPR_ inline Enum::_optional                                 \
+Enum::_from_string_nothrow(const char *name, std::size_t length)               \
 {                                                                              \
     return                                                                     \
         ::better_enums::_map_index<Enum>(                                      \
-            BETTER_ENUMS_NS(Enum)::_value_array, _from_string_loop(name));     \
+            BETTER_ENUMS_NS(Enum)::_value_array,                               \
+            _from_name(name, length, false));                                  \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_IF_EXCEPTIONS(                                                    \
@@ -871,40 +2613,76 @@ BETTER_ENUMS_CONSTEXPR_ inline Enum Enum::_from_string(const char *name)       \
     return                                                                     \
         ::better_enums::_or_throw(_from_string_nothrow(name),                  \
                                   #Enum "::_from_string: invalid argument");   \
+}                                                                              \
+                                                                               \
+BETTER_ENUMS_CONSTEXPR_ inline Enum                                            \
+Enum::_from_string(const char *name, std::size_t length)                       \
+{                                                                              \
+    return                                                                     \
+        ::better_enums::_or_throw(_from_string_nothrow(name, length),          \
+                                  #Enum "::_from_string: invalid argument");   \
 }                                                                              \
 )                                                                              \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline Enum::_optional                                 \
 Enum::_from_string_nocase_nothrow(const char *name)                            \
+{                                                                              \
+    return                                                                     \
+        _from_string_nocase_nothrow(name, ::better_enums::_null_terminated);   \
+}                                                                              \
+                                                                               \
+BETTER_ENUMS_CONSTEXPR_ inline Enum::_optional                                 \
+Enum::_from_string_nocase_nothrow(const char *name, std::size_t length)        \
 {                                                                              \
     return                                                                     \
         ::better_enums::_map_index<Enum>(BETTER_ENUMS_NS(Enum)::_value_array,  \
-                                         _from_string_nocase_loop(name));      \
+                                         _from_name(name, length, true));      \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_IF_EXCEPTIONS(                                                    \
-BETTER_ENUMS_CONSTEXPR_ inline Enum Enum::_from_string_nocase(const char *name)\
+BETTER_ENUMS_CONSTEXPR_ inline Enum Enum::_from_string_nocase(const char *name) \
 {                                                                              \
     return                                                                     \
         ::better_enums::_or_throw(                                             \
             _from_string_nocase_nothrow(name),                                 \
             #Enum "::_from_string_nocase: invalid argument");                  \
+}                                                                              \
+                                                                               \
+BETTER_ENUMS_CONSTEXPR_ inline Enum                                            \
+Enum::_from_string_nocase(const char *name, std::size_t length)                \
+{                                                                              \
+    return                                                                     \
+        ::better_enums::_or_throw(                                             \
+            _from_string_nocase_nothrow(name, length),                         \
+            #Enum "::_from_string_nocase: invalid argument");                  \
 }                                                                              \
 )                                                                              \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline bool Enum::_is_valid(_integral value)           \
 {                                                                              \
-    return _from_value_loop(value);                                            \
+    return _from_value(value);                                                 \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline bool Enum::_is_valid(const char *name)          \
 {                                                                              \
-    return _from_string_loop(name);                                            \
+    return _from_name(name, ::better_enums::_null_terminated, false);          \
+}                                                                              \
+                                                                               \
+BETTER_ENUMS_CONSTEXPR_ inline bool                                            \
+Enum::_is_valid(const char *name, std::size_t length)                          \
+{                                                                              \
+    return _from_name(name, length, false);                                    \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline bool Enum::_is_valid_nocase(const char *name)   \
 {                                                                              \
-    return _from_string_nocase_loop(name);                                     \
+    return _from_name(name, ::better_enums::_null_terminated, true);           \
+}                                                                              \
+                                                                               \
+BETTER_ENUMS_CONSTEXPR_ inline bool                                            \
+Enum::_is_valid_nocase(const char *name, std::size_t length)                   \
+{                                                                              \
+    return _from_name(name, length, true);                                     \
 }                                                                              \
                                                                                \
 BETTER_ENUMS_CONSTEXPR_ inline const char* Enum::_name()                       \
@@ -924,6 +2702,11 @@ ToStringConstexpr inline Enum::_name_iterable Enum::_names()                   \
                        CallInitialize(_size()));                               \
 }                                                                              \
                                                                                \
+ToStringConstexpr inline std::size_t Enum::_name_length(std::size_t index)     \
+{                                                                              \
+    return BETTER_ENUMS_NS(Enum)::_name_lengths()[CallInitialize(index)];      \
+}                                                                              \
+                                                                               \
 DefineInitialize(Enum)                                                         \
                                                                                \
 BETTER_ENUMS_IGNORE_ATTRIBUTES_HEADER                                          \
@@ -965,11 +2748,16 @@ template <typename Char, typename Traits>                                      \
 std::basic_istream<Char, Traits>&                                              \
 operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
 {                                                                              \
-    std::basic_string<Char, Traits>     buffer;                                \
+    char                            buffer[                                    \
+        BETTER_ENUMS_TOKEN_SIZE(Enum, Char)];                                  \
+    std::size_t                     length =                                   \
+        ::better_enums::_read_token(stream, buffer, sizeof(buffer));           \
                                                                                \
-    stream >> buffer;                                                          \
-    ::better_enums::optional<Enum>      converted =                            \
-        Enum::_from_string_nothrow(buffer.c_str());                            \
+    if (!stream)                                                               \
+        return stream;                                                         \
+                                                                               \
+    ::better_enums::optional<Enum>  converted =                                \
+        Enum::_from_string_nothrow(buffer, length);                            \
                                                                                \
     if (converted)                                                             \
         value = *converted;                                                    \
@@ -1037,15 +2825,15 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
         return value;                                                          \
     }                                                                          \
                                                                                \
-    inline bool& _initialized()                                                \
+    inline std::size_t* _name_lengths()                                        \
     {                                                                          \
-        static bool         value = false;                                     \
+        static std::size_t  value[Enum::_size_constant];                       \
         return value;                                                          \
     }
 
 // C++11 fast version
 #define BETTER_ENUMS_CXX11_PARTIAL_CONSTEXPR_TRIM_STRINGS_ARRAYS(Enum, ...)    \
-    constexpr const char    *_the_raw_names[] =                                \
+    BETTER_ENUMS_DATA_ constexpr const char *_the_raw_names[] =                \
         { BETTER_ENUMS_ID(BETTER_ENUMS_STRINGIZE(__VA_ARGS__)) };              \
                                                                                \
     constexpr const char * const * _raw_names()                                \
@@ -1066,9 +2854,9 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
         return value;                                                          \
     }                                                                          \
                                                                                \
-    inline bool& _initialized()                                                \
+    inline std::size_t* _name_lengths()                                        \
     {                                                                          \
-        static bool         value = false;                                     \
+        static std::size_t  value[Enum::_size_constant];                       \
         return value;                                                          \
     }
 
@@ -1076,7 +2864,7 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
 #define BETTER_ENUMS_CXX11_FULL_CONSTEXPR_TRIM_STRINGS_ARRAYS(Enum, ...)       \
     BETTER_ENUMS_ID(BETTER_ENUMS_TRIM_STRINGS(__VA_ARGS__))                    \
                                                                                \
-    constexpr const char * const    _the_name_array[] =                        \
+    BETTER_ENUMS_DATA_ constexpr const char * const _the_name_array[] =        \
         { BETTER_ENUMS_ID(BETTER_ENUMS_REFER_TO_STRINGS(__VA_ARGS__)) };       \
                                                                                \
     constexpr const char * const * _name_array()                               \
@@ -1084,11 +2872,75 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
         return _the_name_array;                                                \
     }                                                                          \
                                                                                \
+    BETTER_ENUMS_DATA_ constexpr const std::size_t  _the_name_lengths[] =      \
+        { BETTER_ENUMS_ID(BETTER_ENUMS_REFER_TO_LENGTHS(__VA_ARGS__)) };       \
+                                                                               \
+    constexpr const std::size_t * _name_lengths()                              \
+    {                                                                          \
+        return _the_name_lengths;                                              \
+    }                                                                          \
+                                                                               \
+    constexpr const char * const * _raw_names()                                \
+    {                                                                          \
+        return _the_name_array;                                                \
+    }
+
+// C++14 all-constexpr version
+#define BETTER_ENUMS_CXX14_CONSTEXPR_TRIM_STRINGS_ARRAYS(Enum, ...)            \
+    BETTER_ENUMS_DATA_ constexpr const char *_the_raw_names[] =                \
+        { BETTER_ENUMS_ID(BETTER_ENUMS_STRINGIZE(__VA_ARGS__)) };              \
+                                                                               \
     constexpr const char * const * _raw_names()                                \
+    {                                                                          \
+        return _the_raw_names;                                                 \
+    }                                                                          \
+                                                                               \
+    BETTER_ENUMS_DATA_ constexpr ::better_enums::_trimmed_names<               \
+        Enum::_size_constant,                                                  \
+        ::better_enums::_trimmed_size(_the_raw_names, Enum::_size_constant)>   \
+                                _trimmed_names(_the_raw_names);                \
+                                                                               \
+    constexpr const char * const * _name_array()                               \
+    {                                                                          \
+        return _trimmed_names.names;                                           \
+    }                                                                          \
+                                                                               \
+    constexpr const std::size_t * _name_lengths()                              \
+    {                                                                          \
+        return _trimmed_names.lengths;                                         \
+    }
+
+// Enums written out by script/make_enums.py, in every mode. The names are
+// already trimmed, and their lengths are the generated _constant_lengths.
+#define BETTER_ENUMS_GENERATED_STRINGS_ARRAYS(Enum, ...)                       \
+    BETTER_ENUMS_DATA_ BETTER_ENUMS_CONSTEXPR_ const char * const              \
+                                _the_name_array[] =                            \
+        { BETTER_ENUMS_GENERATED_TABLE(Enum, names) };                         \
+                                                                               \
+    BETTER_ENUMS_CONSTEXPR_ inline const char * const * _name_array()          \
+    {                                                                          \
+        return _the_name_array;                                                \
+    }                                                                          \
+                                                                               \
+    BETTER_ENUMS_CONSTEXPR_ inline const std::size_t * _name_lengths()         \
+    {                                                                          \
+        return _constant_lengths;                                              \
+    }                                                                          \
+                                                                               \
+    BETTER_ENUMS_CONSTEXPR_ inline const char * const * _raw_names()           \
     {                                                                          \
         return _the_name_array;                                                \
     }
 
+// All-constexpr version for the current language standard
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+#   define BETTER_ENUMS_CONSTEXPR_TRIM_STRINGS_ARRAYS                          \
+        BETTER_ENUMS_CXX14_CONSTEXPR_TRIM_STRINGS_ARRAYS
+#else
+#   define BETTER_ENUMS_CONSTEXPR_TRIM_STRINGS_ARRAYS                          \
+        BETTER_ENUMS_CXX11_FULL_CONSTEXPR_TRIM_STRINGS_ARRAYS
+#endif
+
 // C++98, C++11 fast version
 #define BETTER_ENUMS_NO_CONSTEXPR_TO_STRING_KEYWORD
 
@@ -1104,29 +2956,36 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
 #define BETTER_ENUMS_DECLARE_EMPTY_INITIALIZE                                  \
     static int initialize() { return 0; }
 
-// C++98, C++11 fast version
+// C++98, C++11 fast version. The names are trimmed while initializing a
+// function-local static. Since C++11, this is guaranteed to happen exactly
+// once, even if initialize() is first called by several threads at the same
+// time, and later calls only check the guard of the static with an acquire
+// load. gcc and clang give the same guarantee in C++98, unless
+// -fno-threadsafe-statics is passed.
 #define BETTER_ENUMS_DO_DEFINE_INITIALIZE(Enum)                                \
     inline int Enum::initialize()                                              \
     {                                                                          \
-        if (BETTER_ENUMS_NS(Enum)::_initialized())                             \
-            return 0;                                                          \
-                                                                               \
-        ::better_enums::_trim_names(BETTER_ENUMS_NS(Enum)::_raw_names(),       \
-                                    BETTER_ENUMS_NS(Enum)::_name_array(),      \
-                                    BETTER_ENUMS_NS(Enum)::_name_storage(),    \
-                                    _size());                                  \
-                                                                               \
-        BETTER_ENUMS_NS(Enum)::_initialized() = true;                          \
+        static const int    initialized =                                      \
+            (::better_enums::_trim_names(                                      \
+                BETTER_ENUMS_NS(Enum)::_raw_names(),                           \
+                BETTER_ENUMS_NS(Enum)::_name_array(),                          \
+                BETTER_ENUMS_NS(Enum)::_name_lengths(),                        \
+                BETTER_ENUMS_NS(Enum)::_name_storage(), _size()),              \
+            BETTER_ENUMS_INITIALIZE_NAME_TABLE(Enum)                           \
+            BETTER_ENUMS_REPORT_INITIALIZE(Enum)                               \
+            0);                                                                \
                                                                                \
-        return 0;                                                              \
+        return initialized;                                                    \
     }
 
 // C++11 slow all-constexpr version
 #define BETTER_ENUMS_DO_NOT_DEFINE_INITIALIZE(Enum)
 
-// C++98, C++11 fast version
+// C++98, C++11 fast version. This is a comma expression, rather than a call to
+// continue_with, so that initialize() is sequenced before value is read. The
+// order in which function arguments are evaluated is unspecified.
 #define BETTER_ENUMS_DO_CALL_INITIALIZE(value)                                 \
-    ::better_enums::continue_with(initialize(), value)
+    (static_cast<void>(initialize()), value)
 
 // C++11 slow all-constexpr version
 #define BETTER_ENUMS_DO_NOT_CALL_INITIALIZE(value)                             \
@@ -1150,6 +3009,30 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
 
 
 
+// Names are trimmed on first use anyway, so the initializer that each
+// translation unit runs at program start is only needed when first use might
+// race. Where function-local statics are initialized thread-safely, it is left
+// out, and enums add no dynamic initialization to the program at all.
+// BETTER_ENUMS_EAGER_INITIALIZATION restores it, for programs that would rather
+// pay for trimming before main than on the first call to a string function.
+#ifndef BETTER_ENUMS_EAGER_INITIALIZATION
+#   ifdef BETTER_ENUMS_HAVE_INLINE_DATA
+#       define BETTER_ENUMS_LAZY_INITIALIZATION
+#   elif defined(__cpp_threadsafe_static_init)
+#       define BETTER_ENUMS_LAZY_INITIALIZATION
+#   endif
+#endif
+
+#ifdef BETTER_ENUMS_LAZY_INITIALIZATION
+#   define BETTER_ENUMS_FORCE_INITIALIZATION(Enum)
+#else
+#   define BETTER_ENUMS_FORCE_INITIALIZATION(Enum)                             \
+        static ::better_enums::_initialize_at_program_start<Enum>              \
+                                                    _force_initialization;
+#endif
+
+
+
 #ifndef BETTER_ENUMS_DEFAULT_CONSTRUCTOR
 #   define BETTER_ENUMS_DEFAULT_CONSTRUCTOR(Enum)                              \
       private:                                                                 \
@@ -1162,7 +3045,7 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
 
 #ifdef BETTER_ENUMS_CONSTEXPR_TO_STRING
 #   define BETTER_ENUMS_DEFAULT_TRIM_STRINGS_ARRAYS                            \
-        BETTER_ENUMS_CXX11_FULL_CONSTEXPR_TRIM_STRINGS_ARRAYS
+        BETTER_ENUMS_CONSTEXPR_TRIM_STRINGS_ARRAYS
 #   define BETTER_ENUMS_DEFAULT_TO_STRING_KEYWORD                              \
         BETTER_ENUMS_CONSTEXPR_TO_STRING_KEYWORD
 #   define BETTER_ENUMS_DEFAULT_DECLARE_INITIALIZE                             \
@@ -1198,6 +3081,7 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
         BETTER_ENUMS_DEFAULT_DECLARE_INITIALIZE,                               \
         BETTER_ENUMS_DEFAULT_DEFINE_INITIALIZE,                                \
         BETTER_ENUMS_DEFAULT_CALL_INITIALIZE,                                  \
+        BETTER_ENUMS_DECLARED,                                                 \
         Enum, Underlying, __VA_ARGS__))
 
 #define SLOW_ENUM(Enum, Underlying, ...)                                       \
@@ -1205,11 +3089,26 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
         BETTER_ENUMS_CXX11_UNDERLYING_TYPE,                                    \
         BETTER_ENUMS_DEFAULT_SWITCH_TYPE,                                      \
         BETTER_ENUMS_DEFAULT_SWITCH_TYPE_GENERATE,                             \
-        BETTER_ENUMS_CXX11_FULL_CONSTEXPR_TRIM_STRINGS_ARRAYS,                 \
+        BETTER_ENUMS_CONSTEXPR_TRIM_STRINGS_ARRAYS,                            \
+        BETTER_ENUMS_CONSTEXPR_TO_STRING_KEYWORD,                              \
+        BETTER_ENUMS_DECLARE_EMPTY_INITIALIZE,                                 \
+        BETTER_ENUMS_DO_NOT_DEFINE_INITIALIZE,                                 \
+        BETTER_ENUMS_DO_NOT_CALL_INITIALIZE,                                   \
+        BETTER_ENUMS_DECLARED,                                                 \
+        Enum, Underlying, __VA_ARGS__))
+
+// Used by the headers written by script/make_enums.py.
+#define BETTER_ENUMS_GENERATED_ENUM(Enum, Underlying, ...)                     \
+    BETTER_ENUMS_ID(BETTER_ENUMS_TYPE(                                         \
+        BETTER_ENUMS_CXX11_UNDERLYING_TYPE,                                    \
+        BETTER_ENUMS_DEFAULT_SWITCH_TYPE,                                      \
+        BETTER_ENUMS_DEFAULT_SWITCH_TYPE_GENERATE,                             \
+        BETTER_ENUMS_GENERATED_STRINGS_ARRAYS,                                 \
         BETTER_ENUMS_CONSTEXPR_TO_STRING_KEYWORD,                              \
         BETTER_ENUMS_DECLARE_EMPTY_INITIALIZE,                                 \
         BETTER_ENUMS_DO_NOT_DEFINE_INITIALIZE,                                 \
         BETTER_ENUMS_DO_NOT_CALL_INITIALIZE,                                   \
+        BETTER_ENUMS_GENERATED,                                                \
         Enum, Underlying, __VA_ARGS__))
 
 #else
@@ -1224,12 +3123,28 @@ operator >>(std::basic_istream<Char, Traits>& stream, Enum &value)             \
         BETTER_ENUMS_DO_DECLARE_INITIALIZE,                                    \
         BETTER_ENUMS_DO_DEFINE_INITIALIZE,                                     \
         BETTER_ENUMS_DO_CALL_INITIALIZE,                                       \
+        BETTER_ENUMS_DECLARED,                                                 \
+        Enum, Underlying, __VA_ARGS__))
+
+#define BETTER_ENUMS_GENERATED_ENUM(Enum, Underlying, ...)                     \
+    BETTER_ENUMS_ID(BETTER_ENUMS_TYPE(                                         \
+        BETTER_ENUMS_LEGACY_UNDERLYING_TYPE,                                   \
+        BETTER_ENUMS_DEFAULT_SWITCH_TYPE,                                      \
+        BETTER_ENUMS_DEFAULT_SWITCH_TYPE_GENERATE,                             \
+        BETTER_ENUMS_GENERATED_STRINGS_ARRAYS,                                 \
+        BETTER_ENUMS_NO_CONSTEXPR_TO_STRING_KEYWORD,                           \
+        BETTER_ENUMS_DECLARE_EMPTY_INITIALIZE,                                 \
+        BETTER_ENUMS_DO_NOT_DEFINE_INITIALIZE,                                 \
+        BETTER_ENUMS_DO_NOT_CALL_INITIALIZE,                                   \
+        BETTER_ENUMS_GENERATED,                                                \
         Enum, Underlying, __VA_ARGS__))
 
 #endif
 
 
 
+#ifndef BETTER_ENUMS_MODULE_IMPORTED
+
 namespace better_enums {
 
 // Maps.
@@ -1311,6 +3226,8 @@ BETTER_ENUMS_CONSTEXPR_ map<Enum, T> make_map(T (*f)(Enum))
 
 }
 
+#endif // #ifndef BETTER_ENUMS_MODULE_IMPORTED
+
 #define BETTER_ENUMS_DECLARE_STD_HASH(type)                                    \
 	namespace std {                                                            \
     template <> struct hash<type>                                              \
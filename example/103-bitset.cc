@@ -12,6 +12,7 @@
 #include <bitset>
 #include <iostream>
 #include <enum.h>
+#include <better-enums/enum_set.h>
 
 template <typename Enum>
 constexpr Enum max_loop(Enum accumulator, size_t index)
@@ -52,6 +53,23 @@ int main()
 
     std::cout << eflags << std::endl;
 
+// If the integral values don't have to be the bit indices,
+// extra/better-enums/enum_set.h provides better_enums::enum_set. It has one bit
+// per constant, at the constant's index, so it is only as wide as the number of
+// constants, however sparse their values are. Here, the 14 flags fit in a
+// single unsigned short, where the std::bitset above needs 22 bits. Iterating
+// over an enum_set visits its members in declaration order.
+
+    better_enums::enum_set<EFLAGS>   flags;
+    flags.insert(EFLAGS::Carry).insert(EFLAGS::Zero);
+
+    if (flags.contains(EFLAGS::Carry))
+        flags.insert(EFLAGS::Trap);
+
+    for (EFLAGS flag : flags)
+        std::cout << flag._to_string() << " ";
+    std::cout << flags.size() << std::endl;
+
     return 0;
 }
 
@@ -145,6 +145,33 @@ int main()
 //     return 0;
 // }
 //
+// If you would rather have constexpr identifiers for every enum, there is also
+// get_literal<I>, whose identifier is a better_enums::string_literal, as in
+// N4428. Its length is found at compile time without trimming the name, so it
+// costs little to compile. The difference from N4428 is that, unless names are
+// trimmed at compile time, its characters are those of the constant as
+// declared, such as Red = 1, so they are not followed by a null character. Use
+// data() and size(), iterators, or, in C++17, conversion to std::string_view:
+//
+// // Without compile-time name trimming.
+// BETTER_ENUM(Depth, int, HighColor, TrueColor)
+//
+// constexpr better_enums::string_literal  identifier_1 =
+//     std::enum_traits<Depth>::enumerators::get_literal<1>::identifier;
+//
+// static_assert(identifier_1.size() == 9, "");
+//
+// int main()
+// {
+//     std::cout.write(identifier_1.data(), identifier_1.size());
+//     std::cout << std::endl;
+//
+//     return 0;
+// }
+//
+// better_enums::identifier<Enum>(index) is the same string_literal, for indices
+// that are not template arguments.
+//
 // The future
 //
 // N4428 is the fourth in a series of revisions: N3815, N4027, N4113, N4428. If
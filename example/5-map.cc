@@ -18,15 +18,17 @@
 // natural in C++14. When you pass the function to Better Enums, the library can
 // build up a lookup data structure at compile time.
 //
-// Actually, right now, Better Enums doesn't quite do that - it enumerates the
+// The basic better_enums::map doesn't quite do that - it enumerates the
 // function every time you want to convert to an enum (but not from an enum). It
-// simply does a linear scan every time. This is because I haven't yet found a
-// data structure whose compile-time generation is fast enough for practical
-// use.
+// simply does a linear scan every time. For faster lookup, see sorted_map at
+// the end of this page.
 
 
 #include <iostream>
 #include <enum.h>
+#include <better-enums/enum_map.h>
+#include <better-enums/sorted_map.h>
+#include <better-enums/static_map.h>
 
 BETTER_ENUM(Channel, int, Red, Green, Blue)
 
@@ -70,5 +72,68 @@ int main()
 //
 // Compare has to be a class with a static member function bool less(const T&,
 // const T&). The default implementation better_enums::map_compare simply
-// applies operator <, except when T is const char*. In that case, it does
-// lexicographic comparison.
+// applies operator <, except when T is const char* or const wchar_t*. In that
+// case, it does lexicographic comparison.
+
+// Sorted maps
+//
+// extra/better-enums/sorted_map.h provides better_enums::make_sorted_map, which
+// also takes a function, but calls it only once for each constant, while
+// building the map, and stores the results. from_enum is then an array access,
+// and to_enum is a binary search through the results, sorted with Compare.
+// Neither calls the function again, so lookups do not go through a function
+// pointer. With C++14, the map can be built at compile time:
+
+constexpr auto sorted_descriptions =
+    better_enums::make_sorted_map(describe);
+
+static_assert(sorted_descriptions.to_enum("the blue channel") ==
+              +Channel::Blue, "");
+
+// In C++98 and C++11, it is built at run time instead. The type is
+// better_enums::sorted_map<E, T, Compare>, with the same parameters as
+// better_enums::map, except that T must also be default-constructible. If
+// several constants map to equal values, to_enum returns the one declared
+// first.
+
+// Static maps
+//
+// better_enums::map stores a pointer to the function, so from_enum is a call
+// through that pointer, which compilers rarely inline. sorted_map avoids the
+// calls, but keeps a copy of every result. If the function is known where the
+// map is declared, it can be given as a template argument instead, to the
+// better_enums::static_map of extra/better-enums/static_map.h:
+
+typedef better_enums::static_map<Channel, const char*, describe>
+    StaticDescriptions;
+
+static_assert(StaticDescriptions::to_enum("the red channel") ==
+              +Channel::Red, "");
+
+// from_enum and operator [] then call describe directly, so it can be inlined.
+// from_enum, to_enum, and to_enum_nothrow are static. With C++14, to_enum
+// searches a sorted_map built at compile time, so the function, and less of the
+// Compare argument, which comes last, must be constexpr. In C++98 and C++11,
+// to_enum is a linear scan, like for better_enums::map.
+//
+// With C++17, better_enums::make_static_map<describe>() returns the same map,
+// without having to spell out the type.
+
+// Enum maps
+//
+// To keep a value for every constant, such as a counter or a handler, use
+// better_enums::enum_map<E, T>, from extra/better-enums/enum_map.h, instead of
+// a hash map. It is an array with one entry per constant, indexed by
+// _to_index(), so there is no hashing and no allocation:
+//
+// better_enums::enum_map<Channel, int>   uses;
+// ++uses[Channel::Red];
+//
+// for (auto &entry : uses)
+//     std::cout << entry.first << ": " << entry.second << std::endl;
+//
+// Each entry has the constant in first and its value in second, like the pairs
+// in a std::map, and iteration visits them in declaration order. The elements
+// start out value-initialized. An enum_map can also be constructed from a
+// single value, or from a function like describe, which is called once for each
+// constant. With C++14, that can happen at compile time.
@@ -0,0 +1,148 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides batch conversions of Better Enums, which convert whole
+// arrays of values, indices, or names at once:
+//
+//     std::size_t valid =
+//         better_enums::from_integral_batch(codes, count, results, ok);
+//
+// It works in every mode, and must be included after enum.h.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_BATCH_H
+#define BETTER_ENUMS_BATCH_H
+
+
+
+#include <cstddef>
+
+
+
+namespace better_enums {
+
+// Batch conversions, for converting whole arrays, such as columns of data, at
+// once. Each function converts count inputs, and writes one result for each of
+// them to out. Where inputs can be invalid, ok[index] is set to whether input
+// index is valid, out[index] is set to the first declared constant if it is
+// not, and the number of valid inputs is returned.
+//
+// Whether the enum is sequential is checked only once: at compile time where
+// there is constexpr, and otherwise on the first batch, whose result is kept in
+// a function-local static. For sequential enums, each input is then only
+// compared with the first and last values, and results are selected rather
+// than branched on, so that compilers can vectorize the loop. Other enums use
+// the single-value functions. Strings are given as pointers and lengths, and
+// need not be null-terminated.
+
+#ifndef BETTER_ENUMS_HAVE_CONSTEXPR
+
+template <typename Enum>
+inline bool _scan_sequential()
+{
+    for (std::size_t index = 1; index < Enum::_size_constant; ++index) {
+        typename Enum::_integral    previous =
+            Enum::_values()[index - 1]._value;
+        typename Enum::_integral    current = Enum::_values()[index]._value;
+
+        // current - 1 can't underflow, because current > previous.
+        if (!(previous < current && current - 1 == previous))
+            return false;
+    }
+
+    return true;
+}
+
+#endif // #ifndef BETTER_ENUMS_HAVE_CONSTEXPR
+
+template <typename Enum>
+inline bool _is_sequential()
+{
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    constexpr bool      sequential =
+        _sequential(Enum::_values().begin(), 0, Enum::_size_constant);
+#else
+    static const bool   sequential = _scan_sequential<Enum>();
+#endif
+
+    return sequential;
+}
+
+template <typename Enum>
+std::size_t from_integral_batch(const typename Enum::_integral *in,
+                                std::size_t count, Enum *out, bool *ok)
+{
+    const Enum      first = Enum::_values()[0];
+    std::size_t     valid = 0;
+
+    if (_is_sequential<Enum>()) {
+        const typename Enum::_integral  low = first._value;
+        const typename Enum::_integral  high =
+            Enum::_values()[Enum::_size_constant - 1]._value;
+
+        for (std::size_t index = 0; index < count; ++index) {
+            bool    found = low <= in[index] && in[index] <= high;
+
+            out[index] =
+                Enum::_from_integral_unchecked(found ? in[index] : low);
+            ok[index] = found;
+            valid += found;
+        }
+    }
+    else {
+        for (std::size_t index = 0; index < count; ++index) {
+            optional<Enum>              maybe =
+                Enum::_from_integral_nothrow(in[index]);
+            bool                        found = maybe;
+
+            out[index] = found ? *maybe : first;
+            ok[index] = found;
+            valid += found;
+        }
+    }
+
+    return valid;
+}
+
+template <typename Enum>
+void to_index_batch(const Enum *in, std::size_t count, std::size_t *out)
+{
+    if (_is_sequential<Enum>()) {
+        const typename Enum::_integral  low = Enum::_values()[0]._value;
+
+        for (std::size_t index = 0; index < count; ++index)
+            out[index] = static_cast<std::size_t>(in[index]._value - low);
+    }
+    else {
+        for (std::size_t index = 0; index < count; ++index)
+            out[index] = in[index]._to_index();
+    }
+}
+
+template <typename Enum>
+std::size_t from_string_batch(const char * const *names,
+                              const std::size_t *lengths, std::size_t count,
+                              Enum *out, bool *ok)
+{
+    const Enum      first = Enum::_values()[0];
+    std::size_t     valid = 0;
+
+    for (std::size_t index = 0; index < count; ++index) {
+        optional<Enum>              maybe =
+            Enum::_from_string_nothrow(names[index], lengths[index]);
+        bool                        found = maybe;
+
+        out[index] = found ? *maybe : first;
+        ok[index] = found;
+        valid += found;
+    }
+
+    return valid;
+}
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_BATCH_H
@@ -0,0 +1,52 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file is the interface of the better_enums named module, which exports
+// namespace better_enums from enum.h: optional, the iterables, map,
+// map_compare, the string routines, and the rest of the helpers that the
+// expansions of BETTER_ENUM refer to. It also exports the extras batch.h,
+// enum_map.h, enum_set.h, sorted_map.h, and static_map.h from this directory.
+// It requires C++20. A translation unit that imports the module still needs
+// the macros, which a module can't export, so it includes enum.h after
+// defining BETTER_ENUMS_MODULE_IMPORTED:
+//
+//     #define BETTER_ENUMS_MODULE_IMPORTED
+//     #include <enum.h>
+//
+//     import better_enums;
+//
+//     BETTER_ENUM(Channel, int, Red, Green, Blue)
+//
+// enum.h then skips the library, and only includes <cstddef>, <iosfwd>, and
+// <string_view>, which the expansions use. Some compilers reject standard
+// headers included after a module that includes them too, so the import comes
+// last. The module and the units that import it must be compiled with the same
+// BETTER_ENUMS_* options.
+//
+// With g++ 11 or later, compile this file with -std=c++20 -fmodules-ts -x c++,
+// and the directory of enum.h in the include path, before the units that import
+// the module, which need -std=c++20 -fmodules-ts as well.
+
+module;
+
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <iosfwd>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+export module better_enums;
+
+#define BETTER_ENUMS_MODULE_INTERFACE
+
+export {
+#include <enum.h>
+#include "batch.h"
+#include "enum_map.h"
+#include "enum_set.h"
+#include "sorted_map.h"
+#include "static_map.h"
+}
@@ -0,0 +1,129 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides better_enums::enum_counters, an array of event counters,
+// one for each constant of a Better Enum, that many threads can increment at
+// once. It requires C++11, for std::atomic and thread_local, and must be
+// included after enum.h. It includes enum_map.h, for snapshots.
+//
+// Counters are kept in Shards copies, each aligned to a cache line. Each thread
+// is assigned one copy, the first time it increments any counter, so threads
+// rarely write to the same cache line, and increments are relaxed atomic
+// additions that do not contend across cores. Reading a count adds up
+// the copies. Snapshots are not atomic as a whole: increments that happen
+// while a snapshot is being taken may or may not be included.
+//
+// Shards defaults to BETTER_ENUMS_COUNTER_SHARDS, which is 64, so that up to 64
+// threads, one on each core of a 64-core machine, each get a copy of their own.
+// More threads share copies: this is still correct, but threads that share a
+// copy contend for its cache lines. Each copy takes at least one cache line, so
+// the default costs 4 KiB for an enum of up to 8 constants, and reading a count
+// loads 64 words. Fewer shards, such as the number of cores that will actually
+// increment the counters, use less memory and make reads faster.
+//
+// BETTER_ENUMS_CACHE_LINE_SIZE can be defined before including this file, if
+// the target's cache lines are not 64 bytes. Since the counters are
+// over-aligned, they should have static storage duration, or be allocated with
+// a C++17 operator new, which respects the alignment.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_COUNTERS_H
+#define BETTER_ENUMS_COUNTERS_H
+
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "enum_map.h"
+
+#ifndef BETTER_ENUMS_CACHE_LINE_SIZE
+#define BETTER_ENUMS_CACHE_LINE_SIZE 64
+#endif
+
+#ifndef BETTER_ENUMS_COUNTER_SHARDS
+#define BETTER_ENUMS_COUNTER_SHARDS 64
+#endif
+
+
+
+namespace better_enums {
+
+// Each thread gets the next slot in turn, the first time it asks for one.
+inline std::size_t _counter_slot()
+{
+    static std::atomic<std::size_t>     next_slot(0);
+    thread_local std::size_t            slot =
+        next_slot.fetch_add(1, std::memory_order_relaxed);
+
+    return slot;
+}
+
+template <typename Enum, std::size_t Shards = BETTER_ENUMS_COUNTER_SHARDS>
+class enum_counters {
+  public:
+    typedef enum_map<Enum, std::uint64_t>   snapshot_type;
+
+    enum_counters() { reset(); }
+
+    enum_counters(const enum_counters&) = delete;
+    enum_counters& operator =(const enum_counters&) = delete;
+
+    void increment(Enum value, std::uint64_t amount = 1)
+    {
+        _shards[_counter_slot() % Shards].counts[value._to_index()]
+            .fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    std::uint64_t count(Enum value) const
+    {
+        return _sum(value._to_index());
+    }
+
+    // The constant of each entry gives the name, through _to_string(). The
+    // entries are in declaration order, so they are filled in by index, rather
+    // than through operator [], which would look up the index of each constant.
+    snapshot_type snapshot() const
+    {
+        snapshot_type   result;
+
+        for (std::size_t index = 0; index < Enum::_size_constant; ++index)
+            result.begin()[index].second = _sum(index);
+
+        return result;
+    }
+
+    void reset()
+    {
+        for (std::size_t shard = 0; shard < Shards; ++shard) {
+            for (std::size_t index = 0; index < Enum::_size_constant; ++index) {
+                _shards[shard].counts[index]
+                    .store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+  private:
+    struct alignas(BETTER_ENUMS_CACHE_LINE_SIZE) _shard {
+        std::atomic<std::uint64_t>  counts[Enum::_size_constant];
+    };
+
+    std::uint64_t _sum(std::size_t index) const
+    {
+        std::uint64_t   total = 0;
+        for (std::size_t shard = 0; shard < Shards; ++shard)
+            total += _shards[shard].counts[index].load(
+                std::memory_order_relaxed);
+
+        return total;
+    }
+
+    _shard      _shards[Shards];
+};
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_COUNTERS_H
@@ -0,0 +1,150 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides compact binary encodings of Better Enums, for sending them
+// over the network and storing them in files. It requires C++11, and must be
+// included after enum.h.
+//
+// Enums are encoded as their _to_index(), rather than as their value, so that
+// decoding is a single comparison with _size_constant and an array access,
+// instead of a search for the value. Indices depend on the order in which the
+// constants are declared, so writers should also send fingerprint<Enum>(), and
+// readers should compare it with their own once per file or connection.
+//
+// encode_fixed writes each index in fixed_width<Enum>() bytes, the fewest that
+// hold every index, least significant byte first. encode_varint writes it as an
+// unsigned LEB128 number, seven bits per byte, which takes one byte for the
+// first 128 constants, and at most varint_width<Enum>() bytes.
+//
+// Each function returns one past the last byte it wrote or read. If the output
+// is too short, or the input is truncated or is not the index of any constant,
+// it returns a null pointer instead, and neither value nor the output is
+// written.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_ENCODING_H
+#define BETTER_ENUMS_ENCODING_H
+
+
+
+#include <climits>
+#include <cstddef>
+
+
+
+namespace better_enums {
+
+constexpr std::size_t _bytes_for(std::size_t size, std::size_t bits_per_byte,
+                                 std::size_t bytes = 1)
+{
+    return
+        bytes * bits_per_byte >= sizeof(std::size_t) * CHAR_BIT ||
+        (static_cast<std::size_t>(1) << (bytes * bits_per_byte)) >= size ?
+            bytes :
+        _bytes_for(size, bits_per_byte, bytes + 1);
+}
+
+template <typename Enum>
+constexpr std::size_t fixed_width()
+{
+    return _bytes_for(Enum::_size_constant, 8);
+}
+
+template <typename Enum>
+constexpr std::size_t varint_width()
+{
+    return _bytes_for(Enum::_size_constant, 7);
+}
+
+template <typename Enum>
+unsigned char* encode_fixed(Enum value, unsigned char *first,
+                            unsigned char *last)
+{
+    if (static_cast<std::size_t>(last - first) < fixed_width<Enum>())
+        return nullptr;
+
+    std::size_t index = value._to_index();
+
+    for (std::size_t byte = 0; byte < fixed_width<Enum>(); ++byte) {
+        *first++ = static_cast<unsigned char>(index & 0xff);
+        index >>= 8;
+    }
+
+    return first;
+}
+
+template <typename Enum>
+const unsigned char* decode_fixed(const unsigned char *first,
+                                  const unsigned char *last, Enum &value)
+{
+    if (static_cast<std::size_t>(last - first) < fixed_width<Enum>())
+        return nullptr;
+
+    std::size_t index = 0;
+
+    for (std::size_t byte = 0; byte < fixed_width<Enum>(); ++byte)
+        index |= static_cast<std::size_t>(*first++) << (8 * byte);
+
+    if (index >= Enum::_size_constant)
+        return nullptr;
+
+    value = Enum::_values()[index];
+    return first;
+}
+
+template <typename Enum>
+unsigned char* encode_varint(Enum value, unsigned char *first,
+                             unsigned char *last)
+{
+    std::size_t index = value._to_index();
+    std::size_t length = 1;
+
+    for (std::size_t rest = index >> 7; rest != 0; rest >>= 7)
+        ++length;
+
+    if (static_cast<std::size_t>(last - first) < length)
+        return nullptr;
+
+    for (; length > 1; --length) {
+        *first++ = static_cast<unsigned char>((index & 0x7f) | 0x80);
+        index >>= 7;
+    }
+
+    *first++ = static_cast<unsigned char>(index);
+    return first;
+}
+
+// Encodings longer than varint_width<Enum>() bytes are rejected, even if their
+// extra bytes are only zero padding, so that reading a corrupt byte stream
+// never runs on past the bytes that an index can take.
+template <typename Enum>
+const unsigned char* decode_varint(const unsigned char *first,
+                                   const unsigned char *last, Enum &value)
+{
+    std::size_t index = 0;
+
+    for (std::size_t byte = 0; byte < varint_width<Enum>(); ++byte) {
+        if (first == last)
+            return nullptr;
+
+        unsigned char   c = *first++;
+        index |= static_cast<std::size_t>(c & 0x7f) << (7 * byte);
+
+        if ((c & 0x80) == 0) {
+            if (index >= Enum::_size_constant)
+                return nullptr;
+
+            value = Enum::_values()[index];
+            return first;
+        }
+    }
+
+    return nullptr;
+}
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_ENCODING_H
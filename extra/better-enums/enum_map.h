@@ -0,0 +1,104 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides better_enums::enum_map, an array with one element for
+// each constant of a Better Enum, indexed by the constant:
+//
+//     better_enums::enum_map<Channel, int>    uses;
+//     ++uses[Channel::Red];
+//
+// It works in every mode, and must be included after enum.h.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_ENUM_MAP_H
+#define BETTER_ENUMS_ENUM_MAP_H
+
+
+
+#include <cstddef>
+
+
+
+namespace better_enums {
+
+// Maps from every constant to a value, stored in an array of entries indexed by
+// _to_index(). There is no hashing and no allocation, and a map can be
+// constructed at compile time with relaxed constexpr. T must be
+// default-constructible. Each entry holds the constant in first and its value
+// in second, like the pairs of a std::map, and iterators are pointers to the
+// entries, in declaration order. first must not be assigned.
+
+template <typename Enum, typename T>
+struct _map_entry {
+    Enum        first;
+    T           second;
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ _map_entry() :
+        first(Enum::_values()[0]), second() { }
+};
+
+template <typename Enum, typename T>
+class enum_map {
+  public:
+    typedef Enum                                key_type;
+    typedef T                                   mapped_type;
+    typedef _map_entry<Enum, T>                 value_type;
+    typedef std::size_t                         size_type;
+    typedef value_type*                         iterator;
+    typedef const value_type*                   const_iterator;
+    typedef T (*function)(Enum);
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ enum_map() : _entries() { _set_keys(); }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ explicit enum_map(const T &value) :
+        _entries()
+    {
+        _set_keys();
+        fill(value);
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ explicit enum_map(function f) : _entries()
+    {
+        _set_keys();
+        for (std::size_t index = 0; index < Enum::_size_constant; ++index)
+            _entries[index].second = f(_entries[index].first);
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ T& operator [](Enum key)
+        { return _entries[key._to_index()].second; }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ const T& operator [](Enum key) const
+        { return _entries[key._to_index()].second; }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ void fill(const T &value)
+    {
+        for (std::size_t index = 0; index < Enum::_size_constant; ++index)
+            _entries[index].second = value;
+    }
+
+    BETTER_ENUMS_CONSTEXPR_ static size_type size()
+        { return Enum::_size_constant; }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ iterator begin() { return _entries; }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ iterator end()
+        { return _entries + Enum::_size_constant; }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator begin() const
+        { return _entries; }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator end() const
+        { return _entries + Enum::_size_constant; }
+
+  private:
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ void _set_keys()
+    {
+        for (std::size_t index = 0; index < Enum::_size_constant; ++index)
+            _entries[index].first = Enum::_values()[index];
+    }
+
+    value_type  _entries[Enum::_size_constant];
+};
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_ENUM_MAP_H
@@ -0,0 +1,378 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides better_enums::enum_set, a set of constants of a Better
+// Enum, stored as one bit per constant:
+//
+//     better_enums::enum_set<Permission>  granted;
+//     granted.insert(Permission::Read);
+//
+// It works in every mode, and must be included after enum.h.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_ENUM_SET_H
+#define BETTER_ENUMS_ENUM_SET_H
+
+
+
+#include <climits>
+#include <cstddef>
+#include <iterator>
+
+
+
+namespace better_enums {
+
+// Sets of constants. A set has one bit for each constant, at the constant's
+// index, so a sparse enum takes no more room than a dense one, and set
+// operations never convert values to indices. The bits are packed into the
+// smallest unsigned type that holds them all, or into an array of unsigned
+// long. Union, intersection, and difference operate on whole words, size()
+// counts bits with popcount, and iteration skips from one member to the next
+// by counting trailing zeros. Members are visited in declaration order.
+
+template <std::size_t Bits,
+          int Width = Bits <= sizeof(unsigned char) * CHAR_BIT ? 0 :
+                      Bits <= sizeof(unsigned short) * CHAR_BIT ? 1 :
+                      Bits <= sizeof(unsigned int) * CHAR_BIT ? 2 : 3>
+struct _set_word {
+    typedef unsigned long type;
+};
+
+template <std::size_t Bits>
+struct _set_word<Bits, 0> {
+    typedef unsigned char type;
+};
+
+template <std::size_t Bits>
+struct _set_word<Bits, 1> {
+    typedef unsigned short type;
+};
+
+template <std::size_t Bits>
+struct _set_word<Bits, 2> {
+    typedef unsigned int type;
+};
+
+#if defined(__GNUC__) || defined(__clang__)
+
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t _popcount(unsigned long word)
+{
+    return static_cast<std::size_t>(__builtin_popcountl(word));
+}
+
+// word must not be zero.
+BETTER_ENUMS_CONSTEXPR_ inline std::size_t _trailing_zeros(unsigned long word)
+{
+    return static_cast<std::size_t>(__builtin_ctzl(word));
+}
+
+#else
+
+BETTER_ENUMS_RELAXED_CONSTEXPR_ inline std::size_t _popcount(unsigned long word)
+{
+    std::size_t count = 0;
+    for (; word != 0; word &= word - 1)
+        ++count;
+
+    return count;
+}
+
+BETTER_ENUMS_RELAXED_CONSTEXPR_ inline std::size_t
+_trailing_zeros(unsigned long word)
+{
+    std::size_t count = 0;
+    for (; (word & 1) == 0; word >>= 1)
+        ++count;
+
+    return count;
+}
+
+#endif // #if defined(__GNUC__) || defined(__clang__)
+
+// The type that bit arithmetic on Word is done in: unsigned long, so that
+// narrow words are not promoted to int, or Word itself, if it is wider, such as
+// unsigned long long where unsigned long has 32 bits. Wide words are counted
+// one unsigned long at a time.
+template <typename Word, bool Wide = (sizeof(Word) > sizeof(unsigned long))>
+struct _set_bits {
+    typedef unsigned long type;
+
+    BETTER_ENUMS_CONSTEXPR_ static std::size_t popcount(type word)
+        { return _popcount(word); }
+
+    // word must not be zero.
+    BETTER_ENUMS_CONSTEXPR_ static std::size_t trailing_zeros(type word)
+        { return _trailing_zeros(word); }
+};
+
+template <typename Word>
+struct _set_bits<Word, true> {
+    typedef Word type;
+
+    BETTER_ENUMS_CONSTEXPR_ static std::size_t popcount(type word)
+    {
+        return
+            word == 0 ? 0 :
+            _popcount(static_cast<unsigned long>(word)) +
+            popcount(static_cast<type>(word >> _chunk));
+    }
+
+    BETTER_ENUMS_CONSTEXPR_ static std::size_t trailing_zeros(type word)
+    {
+        return
+            static_cast<unsigned long>(word) != 0 ?
+                _trailing_zeros(static_cast<unsigned long>(word)) :
+            _chunk + trailing_zeros(static_cast<type>(word >> _chunk));
+    }
+
+  private:
+    BETTER_ENUMS_CONSTEXPR_ static const std::size_t    _chunk =
+        sizeof(unsigned long) * CHAR_BIT;
+};
+
+template <typename Enum,
+          typename Word = typename _set_word<Enum::_size_constant>::type>
+class enum_set {
+  public:
+    typedef Enum            value_type;
+    typedef std::size_t     size_type;
+    typedef Word            word_type;
+
+    class const_iterator {
+      public:
+        typedef std::forward_iterator_tag   iterator_category;
+        typedef Enum                        value_type;
+        typedef std::ptrdiff_t              difference_type;
+        typedef const Enum*                 pointer;
+        typedef const Enum&                 reference;
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator() :
+            _set(), _index() { }
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ reference operator *() const
+            { return Enum::_values()[_index]; }
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ pointer operator ->() const
+            { return Enum::_values().begin() + _index; }
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator& operator ++()
+        {
+            _index = _set->_next(_index + 1);
+            return *this;
+        }
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator operator ++(int)
+        {
+            const_iterator  previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ bool
+        operator ==(const const_iterator &other) const
+            { return _index == other._index; }
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ bool
+        operator !=(const const_iterator &other) const
+            { return _index != other._index; }
+
+      private:
+        BETTER_ENUMS_RELAXED_CONSTEXPR_
+        const_iterator(const enum_set *set, std::size_t index) :
+            _set(set), _index(index) { }
+
+        const enum_set  *_set;
+        std::size_t     _index;
+
+        friend class enum_set;
+    };
+
+    typedef const_iterator  iterator;
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ enum_set() : _words() { }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static enum_set all()
+    {
+        enum_set    result;
+
+        for (std::size_t word = 0; word < _word_count; ++word)
+            result._words[word] = static_cast<Word>(_mask(word));
+
+        return result;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ enum_set& insert(Enum value)
+    {
+        std::size_t index = value._to_index();
+        _words[index / _bits] =
+            static_cast<Word>(_words[index / _bits] | _bit(index));
+
+        return *this;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ enum_set& erase(Enum value)
+    {
+        std::size_t index = value._to_index();
+        _words[index / _bits] =
+            static_cast<Word>(_words[index / _bits] & ~_bit(index));
+
+        return *this;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ bool contains(Enum value) const
+    {
+        std::size_t index = value._to_index();
+        return (_words[index / _bits] & _bit(index)) != 0;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ void clear()
+    {
+        for (std::size_t word = 0; word < _word_count; ++word)
+            _words[word] = 0;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ bool empty() const
+    {
+        for (std::size_t word = 0; word < _word_count; ++word) {
+            if (_words[word] != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ size_type size() const
+    {
+        std::size_t count = 0;
+        for (std::size_t word = 0; word < _word_count; ++word)
+            count += _arithmetic::popcount(_words[word]);
+
+        return count;
+    }
+
+    BETTER_ENUMS_CONSTEXPR_ static size_type max_size()
+        { return Enum::_size_constant; }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator begin() const
+        { return const_iterator(this, _next(0)); }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator end() const
+        { return const_iterator(this, Enum::_size_constant); }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ enum_set& operator |=(const enum_set &other)
+    {
+        for (std::size_t word = 0; word < _word_count; ++word)
+            _words[word] = static_cast<Word>(_words[word] | other._words[word]);
+
+        return *this;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ enum_set& operator &=(const enum_set &other)
+    {
+        for (std::size_t word = 0; word < _word_count; ++word)
+            _words[word] = static_cast<Word>(_words[word] & other._words[word]);
+
+        return *this;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ enum_set& operator ^=(const enum_set &other)
+    {
+        for (std::size_t word = 0; word < _word_count; ++word)
+            _words[word] = static_cast<Word>(_words[word] ^ other._words[word]);
+
+        return *this;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ enum_set& operator -=(const enum_set &other)
+    {
+        for (std::size_t word = 0; word < _word_count; ++word)
+            _words[word] =
+                static_cast<Word>(_words[word] & ~other._words[word]);
+
+        return *this;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ enum_set operator ~() const
+    {
+        enum_set    result;
+
+        for (std::size_t word = 0; word < _word_count; ++word)
+            result._words[word] =
+                static_cast<Word>(~_words[word] & _mask(word));
+
+        return result;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ friend enum_set
+    operator |(enum_set a, const enum_set &b) { return a |= b; }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ friend enum_set
+    operator &(enum_set a, const enum_set &b) { return a &= b; }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ friend enum_set
+    operator ^(enum_set a, const enum_set &b) { return a ^= b; }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ friend enum_set
+    operator -(enum_set a, const enum_set &b) { return a -= b; }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ friend bool
+    operator ==(const enum_set &a, const enum_set &b)
+    {
+        for (std::size_t word = 0; word < _word_count; ++word) {
+            if (a._words[word] != b._words[word])
+                return false;
+        }
+
+        return true;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ friend bool
+    operator !=(const enum_set &a, const enum_set &b) { return !(a == b); }
+
+  private:
+    // Bit arithmetic is done in _wide, and the results are converted back to
+    // Word.
+    typedef _set_bits<Word>                 _arithmetic;
+    typedef typename _arithmetic::type      _wide;
+
+    BETTER_ENUMS_CONSTEXPR_ static const std::size_t    _bits =
+        sizeof(Word) * CHAR_BIT;
+    BETTER_ENUMS_CONSTEXPR_ static const std::size_t    _word_count =
+        (Enum::_size_constant + _bits - 1) / _bits;
+
+    BETTER_ENUMS_CONSTEXPR_ static _wide _bit(std::size_t index)
+        { return static_cast<_wide>(1) << (index % _bits); }
+
+    // The bits of word that correspond to constants.
+    BETTER_ENUMS_CONSTEXPR_ static _wide _mask(std::size_t word)
+    {
+        return
+            word + 1 < _word_count || Enum::_size_constant % _bits == 0 ?
+                static_cast<_wide>(static_cast<Word>(~Word(0))) :
+            (static_cast<_wide>(1) << (Enum::_size_constant % _bits)) - 1;
+    }
+
+    // Index of the first member at or after index, or the number of constants.
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ std::size_t _next(std::size_t index) const
+    {
+        std::size_t word = index / _bits;
+        if (word >= _word_count)
+            return Enum::_size_constant;
+
+        _wide remaining =
+            _words[word] & (~static_cast<_wide>(0) << (index % _bits));
+
+        while (remaining == 0) {
+            if (++word == _word_count)
+                return Enum::_size_constant;
+
+            remaining = _words[word];
+        }
+
+        return word * _bits + _arithmetic::trailing_zeros(remaining);
+    }
+
+    Word        _words[_word_count];
+};
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_ENUM_SET_H
@@ -0,0 +1,132 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file lets every Better Enum be formatted by std::format, when compiling
+// as C++20 with a standard library that has <format>, and by fmt::format, if
+// <fmt/format.h> is included before this file. It requires C++11, and must be
+// included after enum.h.
+//
+// Enums are formatted as by _to_string(), and values that are not those of any
+// constant as their integral value, in both cases through _write_to(), into a
+// buffer on the stack, so nothing is allocated. Format specifications are those
+// of strings, so fill, alignment and width work as they do for names passed as
+// string views.
+//
+// BETTER_ENUM can be used inside other namespaces, which can't be closed from
+// within the macro, so the formatters are not generated by it. Instead, there
+// is one partial specialization of each formatter, for all types that are
+// Better Enums.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_FORMAT_H
+#define BETTER_ENUMS_FORMAT_H
+
+
+
+#include <climits>
+#include <cstddef>
+#include <type_traits>
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#   if __has_include(<format>)
+#       include <format>
+#   endif
+#endif
+
+
+
+namespace better_enums {
+
+template <typename T>
+struct _void { typedef void type; };
+
+template <typename T, typename = void>
+struct _is_better_enum : std::false_type { };
+
+template <typename T>
+struct _is_better_enum<T, typename _void<typename T::_name_iterable>::type> :
+    std::true_type { };
+
+// Room for the longest name, or for the longest integral value, written by
+// _write_to.
+template <typename Enum>
+constexpr std::size_t _formatted_size()
+{
+    return
+        Enum::_max_name_length_constant >
+            sizeof(typename Enum::_integral) * CHAR_BIT / 3 + 2 ?
+        Enum::_max_name_length_constant :
+        sizeof(typename Enum::_integral) * CHAR_BIT / 3 + 2;
+}
+
+// Calls use with the characters of value, converted to Char. Names and digits
+// are ASCII, so each character is converted on its own.
+template <typename Char, typename Enum, typename Use>
+auto _with_formatted(Enum value, Use use) -> decltype(use(nullptr, 0))
+{
+    char        narrow[_formatted_size<Enum>()];
+    Char        converted[_formatted_size<Enum>()];
+    std::size_t length =
+        static_cast<std::size_t>(
+            value._write_to(narrow, narrow + sizeof(narrow)) - narrow);
+
+    for (std::size_t index = 0; index < length; ++index)
+        converted[index] = static_cast<Char>(narrow[index]);
+
+    return use(static_cast<const Char*>(converted), length);
+}
+
+}
+
+#ifdef __cpp_lib_format
+
+namespace std {
+
+template <typename Enum, typename Char>
+    requires better_enums::_is_better_enum<Enum>::value
+struct formatter<Enum, Char> : formatter<basic_string_view<Char>, Char> {
+
+    template <typename Context>
+    auto format(Enum value, Context &context) const
+    {
+        return better_enums::_with_formatted<Char>(value,
+            [&](const Char *characters, std::size_t length) {
+                return formatter<basic_string_view<Char>, Char>::format(
+                    basic_string_view<Char>(characters, length), context);
+            });
+    }
+};
+
+}
+
+#endif // #ifdef __cpp_lib_format
+
+#ifdef FMT_VERSION
+
+namespace fmt {
+
+template <typename Enum, typename Char>
+struct formatter<
+    Enum, Char,
+    typename std::enable_if<better_enums::_is_better_enum<Enum>::value>::type> :
+    formatter<basic_string_view<Char>, Char> {
+
+    template <typename Context>
+    auto format(Enum value, Context &context) const -> decltype(context.out())
+    {
+        return better_enums::_with_formatted<Char>(value,
+            [&](const Char *characters, std::size_t length) {
+                return formatter<basic_string_view<Char>, Char>::format(
+                    basic_string_view<Char>(characters, length), context);
+            });
+    }
+};
+
+}
+
+#endif // #ifdef FMT_VERSION
+
+
+
+#endif // #ifndef BETTER_ENUMS_FORMAT_H
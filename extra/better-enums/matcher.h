@@ -0,0 +1,230 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides better_enums::matcher, which looks up the name of a Better
+// Enum constant as its characters arrive, one at a time or in chunks, so that
+// parsers which see input split across buffers don't have to accumulate each
+// token first. It requires C++11, and must be included after enum.h.
+//
+// After each character, the matcher reports whether the input so far is a name
+// (match), a proper prefix of some name (undecided), or neither (no_match). A
+// name can also be a prefix of a longer name, so a match is only final once
+// the caller knows that the token has ended. After a mismatch, the matcher
+// ignores further input, so invalid tokens are rejected at their first wrong
+// character.
+//
+// The matcher keeps no copy of the input. It relies on a table, built once per
+// enum when a matcher is first constructed, of the constants in order of their
+// names with case folded as by _from_string_nocase, and the constants declared
+// first coming first among names that differ only in case. The names that
+// start with any prefix, with case folded, are then a contiguous range of the
+// table, and each character narrows the range by binary search. matcher<Enum>
+// and nocase_matcher<Enum> share this table. matcher<Enum> also tracks the
+// first constant in the range whose name matches the input exactly, which
+// almost always stays the same from one character to the next.
+//
+// The table is not built at compile time, because in the default C++11 mode
+// the names are only trimmed at run time.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_MATCHER_H
+#define BETTER_ENUMS_MATCHER_H
+
+
+
+#include <algorithm>
+#include <cstddef>
+
+
+
+namespace better_enums {
+
+enum class match_status { no_match, undecided, match };
+
+template <typename Enum>
+class _matcher_table {
+  public:
+    static const _matcher_table& instance()
+    {
+        static const _matcher_table table;
+        return table;
+    }
+
+    // The character at position of the name of the constant at rank in the
+    // table, with case folded, or -1 if the name has already ended. Ranks in a
+    // range whose names share their first position characters are in order of
+    // this key.
+    int key(std::size_t rank, std::size_t position) const
+    {
+        return
+            lengths[order[rank]] == position ? -1 :
+            static_cast<unsigned char>(
+                _to_lower_ascii(names[order[rank]][position]));
+    }
+
+    const char      *names[Enum::_size_constant];
+    std::size_t     lengths[Enum::_size_constant];
+    std::size_t     order[Enum::_size_constant];
+
+  private:
+    _matcher_table()
+    {
+        for (std::size_t index = 0; index < Enum::_size_constant; ++index) {
+            names[index] = Enum::_names()[index];
+            lengths[index] = Enum::_name_length(index);
+            order[index] = index;
+        }
+
+        std::stable_sort(order, order + Enum::_size_constant,
+                         [this](std::size_t a, std::size_t b) {
+            for (std::size_t position = 0; ; ++position) {
+                if (position == lengths[b])
+                    return false;
+                if (position == lengths[a])
+                    return true;
+
+                unsigned char   folded_a = static_cast<unsigned char>(
+                    _to_lower_ascii(names[a][position]));
+                unsigned char   folded_b = static_cast<unsigned char>(
+                    _to_lower_ascii(names[b][position]));
+
+                if (folded_a != folded_b)
+                    return folded_a < folded_b;
+            }
+        });
+    }
+};
+
+template <typename Enum, bool Nocase = false>
+class matcher {
+  public:
+    matcher() : _table(&_matcher_table<Enum>::instance()) { reset(); }
+
+    void reset()
+    {
+        _begin = 0;
+        _end = Enum::_size_constant;
+        _candidate = 0;
+        _position = 0;
+        _status = match_status::undecided;
+    }
+
+    match_status feed(char c)
+    {
+        if (_status == match_status::no_match)
+            return _status;
+
+        int         folded = static_cast<unsigned char>(_to_lower_ascii(c));
+        std::size_t begin = _search(_begin, _end, folded, false);
+        std::size_t end = _search(begin, _end, folded, true);
+
+        if (begin == end)
+            return _fail();
+
+        std::size_t candidate = begin;
+
+        if (!Nocase) {
+            if (candidate < _candidate)
+                candidate = _candidate;
+
+            while (candidate < end && !_extends(candidate, c))
+                ++candidate;
+
+            if (candidate == end)
+                return _fail();
+        }
+
+        _candidate = candidate;
+        _begin = begin;
+        _end = end;
+        ++_position;
+
+        _status =
+            _table->lengths[_table->order[_candidate]] == _position ?
+                match_status::match : match_status::undecided;
+
+        return _status;
+    }
+
+    match_status feed(const char *chunk, std::size_t length)
+    {
+        for (std::size_t index = 0;
+             index < length && _status != match_status::no_match; ++index) {
+
+            feed(chunk[index]);
+        }
+
+        return _status;
+    }
+
+    match_status status() const { return _status; }
+
+    // The number of characters consumed, up to and including the first one
+    // that did not match.
+    std::size_t length() const
+        { return _position + (_status == match_status::no_match ? 1 : 0); }
+
+    optional<Enum> result() const
+    {
+        return
+            _status == match_status::match ?
+                optional<Enum>(Enum::_values()[_table->order[_candidate]]) :
+                optional<Enum>();
+    }
+
+  private:
+    // The first rank from first to last whose key at _position is not less
+    // than key, or, if upper, is greater than key.
+    std::size_t _search(std::size_t first, std::size_t last, int key,
+                        bool upper) const
+    {
+        while (first < last) {
+            std::size_t middle = first + (last - first) / 2;
+            int         found = _table->key(middle, _position);
+
+            if (found < key || (upper && found == key))
+                first = middle + 1;
+            else
+                last = middle;
+        }
+
+        return first;
+    }
+
+    // Whether the name at rank, which is known to match the input with case
+    // folded, matches it exactly, once c is appended. The names at ranks
+    // before _candidate don't, and the name at _candidate matches all but c.
+    bool _extends(std::size_t rank, char c) const
+    {
+        const char  *name = _table->names[_table->order[rank]];
+
+        return
+            name[_position] == c &&
+            (rank == _candidate ||
+             std::memcmp(name, _table->names[_table->order[_candidate]],
+                         _position) == 0);
+    }
+
+    match_status _fail()
+    {
+        _status = match_status::no_match;
+        return _status;
+    }
+
+    const _matcher_table<Enum>  *_table;
+    std::size_t                 _begin;
+    std::size_t                 _end;
+    std::size_t                 _candidate;
+    std::size_t                 _position;
+    match_status                _status;
+};
+
+template <typename Enum>
+using nocase_matcher = matcher<Enum, true>;
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_MATCHER_H
@@ -17,6 +17,49 @@
 
 
 
+#include <cstddef>
+
+
+
+namespace better_enums {
+
+// The characters of an identifier, and their number. Unlike the string_literal
+// of N4428, this is not necessarily followed by a null character: unless names
+// are trimmed at compile time, it points to the constant as declared, such as
+// "Red = 1", and only the length is that of the name.
+class string_literal {
+  public:
+    constexpr string_literal(const char *data, std::size_t size) :
+        _data(data), _size(size) { }
+
+    constexpr const char* data() const { return _data; }
+    constexpr std::size_t size() const { return _size; }
+
+    constexpr const char* begin() const { return _data; }
+    constexpr const char* end() const { return _data + _size; }
+
+    constexpr char operator [](std::size_t index) const
+        { return _data[index]; }
+
+#ifdef BETTER_ENUMS_HAVE_STRING_VIEW
+    constexpr operator std::string_view() const
+        { return std::string_view(_data, _size); }
+#endif
+
+  private:
+    const char      *_data;
+    std::size_t     _size;
+};
+
+template <typename Enum>
+constexpr string_literal identifier(std::size_t index)
+{
+    return string_literal(Enum::_declared_name(index),
+                          declared_name_length<Enum>(index));
+}
+
+}
+
 namespace std {
 
 template <typename Enum>
@@ -42,9 +85,35 @@ struct enum_traits {
             constexpr static Enum       value = Enum::_values()[Index];
             static const char* identifier() { return Enum::_names()[Index]; };
         };
+
+        // get_literal is N4428 as proposed, with identifier a string_literal.
+        // The length of each name is found at compile time, without trimming
+        // it, so this works for all Better Enums, and costs little to compile.
+        template <size_t Index>
+        struct get_literal {
+            constexpr static Enum       value = Enum::_values()[Index];
+            constexpr static better_enums::string_literal
+                                        identifier =
+                better_enums::identifier<Enum>(Index);
+        };
     };
 };
 
+// Before C++17, static constexpr data members that are used by reference, for
+// example to call string_literal::size(), must also be defined.
+#if __cplusplus < 201703L
+
+template <typename Enum>
+template <size_t Index>
+constexpr Enum enum_traits<Enum>::enumerators::get_literal<Index>::value;
+
+template <typename Enum>
+template <size_t Index>
+constexpr better_enums::string_literal
+enum_traits<Enum>::enumerators::get_literal<Index>::identifier;
+
+#endif
+
 }
 
 
@@ -0,0 +1,308 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides better_enums::packed_vector, a vector of Better Enums that
+// stores each element in only as many bits as it takes to number the constants
+// of the enum, and better_enums::packed_view, which accesses elements stored
+// the same way in a buffer owned by someone else. It requires C++11, and must
+// be included after enum.h.
+//
+// Each element is stored as its _to_index(), in bits_per_element() bits, which
+// is ceil(log2(Enum::_size_constant)), and at least 1. Elements are not split
+// across words: each Word holds elements_per_word() of them, the first one in
+// the lowest bits, and the bits left over at the top of each word are zero. An
+// enum of 10 constants takes 4 bits per element, so 16 elements fit in each
+// 64-bit word.
+//
+// Single elements are accessed through proxy references. pack and unpack
+// convert whole arrays of enums to and from words, one word at a time, and are
+// much faster for bulk conversions than going through the proxies.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_PACKED_H
+#define BETTER_ENUMS_PACKED_H
+
+
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+
+namespace better_enums {
+
+constexpr std::size_t _bits_for(std::size_t size, std::size_t bits = 1)
+{
+    return
+        bits >= sizeof(std::size_t) * CHAR_BIT ||
+        (static_cast<std::size_t>(1) << bits) >= size ? bits :
+        _bits_for(size, bits + 1);
+}
+
+template <typename Enum, typename Word>
+struct _packed_layout {
+    constexpr static std::size_t bits_per_element()
+        { return _bits_for(Enum::_size_constant); }
+    constexpr static std::size_t elements_per_word()
+        { return sizeof(Word) * CHAR_BIT / bits_per_element(); }
+    constexpr static Word mask()
+        { return static_cast<Word>(static_cast<Word>(~static_cast<Word>(0)) >>
+                     (sizeof(Word) * CHAR_BIT - bits_per_element())); }
+
+    constexpr static std::size_t words_for(std::size_t count)
+        { return (count + elements_per_word() - 1) / elements_per_word(); }
+
+    constexpr static std::size_t shift(std::size_t index)
+        { return index % elements_per_word() * bits_per_element(); }
+
+    static_assert(bits_per_element() <= sizeof(Word) * CHAR_BIT,
+                  "Word is too narrow to hold an element");
+
+    static Enum get(const Word *words, std::size_t index)
+    {
+        return Enum::_values()[static_cast<std::size_t>(
+            words[index / elements_per_word()] >> shift(index) & mask())];
+    }
+
+    static void set(Word *words, std::size_t index, Enum value)
+    {
+        Word        &word = words[index / elements_per_word()];
+        std::size_t offset = shift(index);
+
+        word = static_cast<Word>(
+            (word & ~static_cast<Word>(mask() << offset)) |
+            static_cast<Word>(static_cast<Word>(value._to_index()) << offset));
+    }
+};
+
+// Packs count enums from values into _packed_layout<Enum, Word>::words_for(
+// count) words. Unused bits of the last word are set to zero.
+template <typename Enum, typename Word>
+void pack(const Enum *values, std::size_t count, Word *words)
+{
+    typedef _packed_layout<Enum, Word>  layout;
+
+    for (std::size_t first = 0; first < count;
+         first += layout::elements_per_word()) {
+
+        std::size_t in_word = count - first < layout::elements_per_word() ?
+                                count - first : layout::elements_per_word();
+        Word        word = 0;
+
+        for (std::size_t element = 0; element < in_word; ++element) {
+            word = static_cast<Word>(word | static_cast<Word>(
+                static_cast<Word>(values[first + element]._to_index()) <<
+                    element * layout::bits_per_element()));
+        }
+
+        *words++ = word;
+    }
+}
+
+// Unpacks count enums from words into values.
+template <typename Enum, typename Word>
+void unpack(const Word *words, std::size_t count, Enum *values)
+{
+    typedef _packed_layout<Enum, Word>  layout;
+
+    for (std::size_t first = 0; first < count;
+         first += layout::elements_per_word()) {
+
+        std::size_t in_word = count - first < layout::elements_per_word() ?
+                                count - first : layout::elements_per_word();
+        Word        word = *words++;
+
+        for (std::size_t element = 0; element < in_word; ++element) {
+            values[first + element] = Enum::_values()[
+                static_cast<std::size_t>(word & layout::mask())];
+            word = static_cast<Word>(
+                word >> (layout::bits_per_element() - 1) >> 1);
+        }
+    }
+}
+
+template <typename Enum, typename Word = std::uint64_t>
+class packed_view;
+
+template <typename Enum, typename Word = std::uint64_t>
+class packed_vector;
+
+template <typename Enum, typename Word>
+class packed_reference {
+  public:
+    operator Enum() const
+        { return _packed_layout<Enum, Word>::get(_words, _index); }
+
+    packed_reference& operator =(Enum value)
+    {
+        _packed_layout<Enum, Word>::set(_words, _index, value);
+        return *this;
+    }
+
+    packed_reference& operator =(const packed_reference &other)
+        { return *this = static_cast<Enum>(other); }
+
+  private:
+    packed_reference(Word *words, std::size_t index) :
+        _words(words), _index(index) { }
+
+    Word            *_words;
+    std::size_t     _index;
+
+    template <typename, typename> friend class packed_view;
+    template <typename, typename> friend class packed_vector;
+};
+
+template <typename Enum, typename Word>
+class packed_view {
+  public:
+    typedef Enum                            value_type;
+    typedef std::size_t                     size_type;
+    typedef Word                            word_type;
+    typedef packed_reference<Enum, Word>    reference;
+
+    constexpr static std::size_t bits_per_element()
+        { return _packed_layout<Enum, Word>::bits_per_element(); }
+    constexpr static std::size_t elements_per_word()
+        { return _packed_layout<Enum, Word>::elements_per_word(); }
+    constexpr static std::size_t words_for(std::size_t count)
+        { return _packed_layout<Enum, Word>::words_for(count); }
+
+    // words must hold at least words_for(size) words.
+    packed_view(Word *words, std::size_t size) : _words(words), _size(size) { }
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    Word* data() const { return _words; }
+    std::size_t word_count() const { return words_for(_size); }
+
+    reference operator [](std::size_t index) const
+        { return reference(_words, index); }
+
+    Enum get(std::size_t index) const
+        { return _packed_layout<Enum, Word>::get(_words, index); }
+    void set(std::size_t index, Enum value) const
+        { _packed_layout<Enum, Word>::set(_words, index, value); }
+
+    void assign(const Enum *values) const { pack(values, _size, _words); }
+    void copy_to(Enum *values) const { unpack(_words, _size, values); }
+
+  private:
+    Word            *_words;
+    std::size_t     _size;
+};
+
+template <typename Enum, typename Word>
+class packed_vector {
+  public:
+    typedef Enum                            value_type;
+    typedef std::size_t                     size_type;
+    typedef Word                            word_type;
+    typedef packed_reference<Enum, Word>    reference;
+    typedef Enum                            const_reference;
+
+    constexpr static std::size_t bits_per_element()
+        { return _packed_layout<Enum, Word>::bits_per_element(); }
+    constexpr static std::size_t elements_per_word()
+        { return _packed_layout<Enum, Word>::elements_per_word(); }
+
+    packed_vector() : _words(), _size(0) { }
+
+    // Elements that are not given a value are the first declared constant,
+    // since its index is 0.
+    explicit packed_vector(std::size_t size) :
+        _words(_layout::words_for(size)), _size(size) { }
+
+    packed_vector(std::size_t size, Enum value) : _words(), _size(0)
+        { resize(size, value); }
+
+    packed_vector(const Enum *values, std::size_t size) :
+        _words(_layout::words_for(size)), _size(size)
+        { pack(values, size, _words.data()); }
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    std::size_t capacity() const
+        { return _words.capacity() * elements_per_word(); }
+
+    void reserve(std::size_t size)
+        { _words.reserve(_layout::words_for(size)); }
+
+    reference operator [](std::size_t index)
+        { return reference(_words.data(), index); }
+    Enum operator [](std::size_t index) const
+        { return _layout::get(_words.data(), index); }
+
+    void push_back(Enum value)
+    {
+        if (_size % elements_per_word() == 0)
+            _words.push_back(0);
+
+        _layout::set(_words.data(), _size++, value);
+    }
+
+    void pop_back()
+    {
+        --_size;
+        _layout::set(_words.data(), _size, Enum::_values()[0]);
+
+        if (_size % elements_per_word() == 0)
+            _words.pop_back();
+    }
+
+    void resize(std::size_t size)
+        { resize(size, Enum::_values()[0]); }
+
+    void resize(std::size_t size, Enum value)
+    {
+        while (_size > size)
+            pop_back();
+
+        _words.reserve(_layout::words_for(size));
+        while (_size < size)
+            push_back(value);
+    }
+
+    void clear()
+    {
+        _words.clear();
+        _size = 0;
+    }
+
+    Word* data() { return _words.data(); }
+    const Word* data() const { return _words.data(); }
+    std::size_t word_count() const { return _words.size(); }
+
+    packed_view<Enum, Word> view()
+        { return packed_view<Enum, Word>(_words.data(), _size); }
+
+    void assign(const Enum *values, std::size_t size)
+    {
+        _words.resize(_layout::words_for(size));
+        _size = size;
+        pack(values, size, _words.data());
+    }
+
+    void copy_to(Enum *values) const { unpack(_words.data(), _size, values); }
+
+    friend bool operator ==(const packed_vector &a, const packed_vector &b)
+        { return a._size == b._size && a._words == b._words; }
+    friend bool operator !=(const packed_vector &a, const packed_vector &b)
+        { return !(a == b); }
+
+  private:
+    typedef _packed_layout<Enum, Word>  _layout;
+
+    std::vector<Word>   _words;
+    std::size_t         _size;
+};
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_PACKED_H
@@ -0,0 +1,142 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides better_enums::sorted_map, a map between a Better Enum and
+// another type, like better_enums::map, but with its lookup tables computed
+// once, when it is constructed:
+//
+//     const better_enums::sorted_map<Channel, const char*>    descriptions =
+//         better_enums::make_sorted_map(describe);
+//
+// It works in every mode, and must be included after enum.h.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_SORTED_MAP_H
+#define BETTER_ENUMS_SORTED_MAP_H
+
+
+
+#include <cstddef>
+
+
+
+namespace better_enums {
+
+// Maps with precomputed tables. The function is called once for each constant,
+// when the map is constructed, and never again. from_enum is then an array
+// access, and to_enum is a binary search through the results, sorted with
+// Compare. With relaxed constexpr, the map can be constructed at compile time.
+// Otherwise, it is constructed at run time. T must be default-constructible.
+//
+// If several constants map to equal values, to_enum returns the one declared
+// first, like map::to_enum does.
+template <typename Enum, typename T, typename Compare = map_compare<T> >
+struct sorted_map {
+    typedef T (*function)(Enum);
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ explicit sorted_map(function f) :
+        _results(), _order()
+    {
+        for (std::size_t index = 0; index < Enum::_size_constant; ++index) {
+            _results[index] = f(Enum::_values()[index]);
+            _order[index] = static_cast<_index>(index);
+        }
+
+        for (std::size_t root = Enum::_size_constant / 2; root > 0; --root)
+            _sift_down(root - 1, Enum::_size_constant);
+
+        for (std::size_t end = Enum::_size_constant; end > 1; --end) {
+            _index last = _order[end - 1];
+            _order[end - 1] = _order[0];
+            _order[0] = last;
+
+            _sift_down(0, end - 1);
+        }
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ T from_enum(Enum value) const
+        { return _results[value._to_index()]; }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ T operator [](Enum value) const
+        { return _results[value._to_index()]; }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ Enum to_enum(T value) const
+    {
+        return
+            _or_throw(to_enum_nothrow(value),
+                      "sorted_map::to_enum: invalid argument");
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ optional<Enum>
+    to_enum_nothrow(T value) const
+    {
+        std::size_t low = 0;
+        std::size_t high = Enum::_size_constant;
+
+        while (low < high) {
+            std::size_t middle = low + (high - low) / 2;
+
+            if (Compare::less(_results[_order[middle]], value))
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        if (low == Enum::_size_constant ||
+            Compare::less(value, _results[_order[low]])) {
+
+            return optional<Enum>();
+        }
+
+        return Enum::_values()[_order[low]];
+    }
+
+  private:
+    typedef typename _index_type<Enum::_size_constant>::type    _index;
+
+    // Orders constants by result, and constants with equal results by index.
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ bool
+    _before(std::size_t a, std::size_t b) const
+    {
+        return
+            Compare::less(_results[a], _results[b]) ? true :
+            Compare::less(_results[b], _results[a]) ? false :
+            a < b;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ void
+    _sift_down(std::size_t root, std::size_t end)
+    {
+        for (std::size_t child = 2 * root + 1; child < end;
+             child = 2 * root + 1) {
+
+            if (child + 1 < end && _before(_order[child], _order[child + 1]))
+                ++child;
+
+            if (!_before(_order[root], _order[child]))
+                return;
+
+            _index parent = _order[root];
+            _order[root] = _order[child];
+            _order[child] = parent;
+
+            root = child;
+        }
+    }
+
+    T           _results[Enum::_size_constant];
+    _index      _order[Enum::_size_constant];
+};
+
+template <typename Enum, typename T>
+BETTER_ENUMS_RELAXED_CONSTEXPR_ sorted_map<Enum, T>
+make_sorted_map(T (*f)(Enum))
+{
+    return sorted_map<Enum, T>(f);
+}
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_SORTED_MAP_H
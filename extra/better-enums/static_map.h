@@ -0,0 +1,106 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides better_enums::static_map, a map between a Better Enum and
+// another type whose function is a template argument, so that calls to it can
+// be inlined:
+//
+//     typedef better_enums::static_map<Channel, const char*, describe>
+//         Descriptions;
+//
+// It works in every mode, and must be included after enum.h. With relaxed
+// constexpr, to_enum searches a sorted_map, from sorted_map.h, which this file
+// includes.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_STATIC_MAP_H
+#define BETTER_ENUMS_STATIC_MAP_H
+
+
+
+#include <cstddef>
+#include "sorted_map.h"
+
+
+
+namespace better_enums {
+
+// Maps whose function is a template argument. Since the function is known at
+// compile time, from_enum calls it directly, and the compiler can inline it. A
+// switch statement that returns constants is then compiled like any other
+// switch, often into a table load, rather than called through a pointer. With
+// relaxed constexpr, to_enum searches a sorted_map that is built at compile
+// time, so the function and Compare::less must then be constexpr. Otherwise,
+// to_enum is a linear scan, like map::to_enum, but with direct calls.
+template <typename Enum, typename T, T (*Function)(Enum),
+          typename Compare = map_compare<T> >
+struct static_map {
+    BETTER_ENUMS_CONSTEXPR_ static T from_enum(Enum value)
+        { return Function(value); }
+    BETTER_ENUMS_CONSTEXPR_ T operator [](Enum value) const
+        { return Function(value); }
+
+    BETTER_ENUMS_CONSTEXPR_ static Enum to_enum(T value)
+    {
+        return
+            _or_throw(to_enum_nothrow(value),
+                      "static_map::to_enum: invalid argument");
+    }
+
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+
+    constexpr static optional<Enum> to_enum_nothrow(T value)
+        { return _table.to_enum_nothrow(value); }
+
+  private:
+    static constexpr sorted_map<Enum, T, Compare>   _table =
+        sorted_map<Enum, T, Compare>(Function);
+
+#else
+
+    BETTER_ENUMS_CONSTEXPR_ static optional<Enum>
+    to_enum_nothrow(T value, std::size_t index = 0)
+    {
+        return
+            index >= Enum::_size() ? optional<Enum>() :
+            Compare::less(Function(Enum::_values()[index]), value) ||
+            Compare::less(value, Function(Enum::_values()[index])) ?
+                to_enum_nothrow(value, index + 1) :
+            Enum::_values()[index];
+    }
+
+#endif // #ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+};
+
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+
+template <typename Enum, typename T, T (*Function)(Enum), typename Compare>
+constexpr sorted_map<Enum, T, Compare>
+    static_map<Enum, T, Function, Compare>::_table;
+
+#endif // #ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+
+#ifdef BETTER_ENUMS_HAVE_AUTO_TEMPLATE_PARAMETER
+
+template <typename Function, Function f>
+struct _static_map_of;
+
+template <typename Enum, typename T, T (*f)(Enum)>
+struct _static_map_of<T (*)(Enum), f> {
+    typedef static_map<Enum, T, f>  type;
+};
+
+template <auto f>
+constexpr typename _static_map_of<decltype(f), f>::type make_static_map()
+{
+    return typename _static_map_of<decltype(f), f>::type();
+}
+
+#endif // #ifdef BETTER_ENUMS_HAVE_AUTO_TEMPLATE_PARAMETER
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_STATIC_MAP_H
@@ -0,0 +1,239 @@
+// This file is part of Better Enums, released under the BSD 2-clause license.
+// See doc/LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+// This file provides better_enums::subset, a named, fixed subset of the
+// constants of a Better Enum, such as the error codes that can be retried:
+//
+//     typedef better_enums::subset<Error, Error::Timeout, Error::Busy>
+//         Retryable;
+//
+//     if (Retryable::contains(error))
+//         ...
+//
+// It requires C++11, and must be included after enum.h. It includes
+// enum_set.h, for set().
+//
+// The members are template arguments, so the set is built at compile time, as
+// a bitmask with one bit for each constant, at the constant's index, packed
+// into words the same way as in better_enums::enum_set. contains() is then
+// _to_index(), a shift, and a test, and iteration skips from one member to the
+// next by counting trailing zeros. Members are visited in declaration order,
+// and a constant listed more than once, or with the same value as another, is
+// only a member once.
+
+#pragma once
+
+#ifndef BETTER_ENUMS_SUBSET_H
+#define BETTER_ENUMS_SUBSET_H
+
+
+
+#include <climits>
+#include <cstddef>
+#include <iterator>
+#include "enum_set.h"
+
+
+
+namespace better_enums {
+
+constexpr std::size_t _first(std::size_t a, std::size_t b)
+{
+    return a < b ? a : b;
+}
+
+// The index of the first constant with value, or _size_constant. Unlike
+// _to_index() in C++11, this searches the whole enum at every call, but its
+// recursion is only as deep as the logarithm of the number of constants, so it
+// stays under the compiler's limit for large, sparse enums.
+template <typename Enum>
+constexpr std::size_t _subset_index(typename Enum::_integral value,
+                                    std::size_t begin, std::size_t end)
+{
+    return
+        end - begin == 1 ?
+            (Enum::_values()[begin]._value == value ?
+                begin : Enum::_size_constant) :
+        _first(_subset_index<Enum>(value, begin, begin + (end - begin) / 2),
+               _subset_index<Enum>(value, begin + (end - begin) / 2, end));
+}
+
+template <typename Wide>
+constexpr Wide _subset_bits(std::size_t, std::size_t)
+{
+    return 0;
+}
+
+// The bits of word that are set for the constants at the given indices,
+// computed in Wide, the type given by _set_bits for the word type.
+template <typename Wide, typename... Indices>
+constexpr Wide _subset_bits(std::size_t bits, std::size_t word,
+                            std::size_t index, Indices... indices)
+{
+    return
+        (index / bits == word ?
+            static_cast<Wide>(1) << (index % bits) : static_cast<Wide>(0)) |
+        _subset_bits<Wide>(bits, word, indices...);
+}
+
+template <typename Enum, typename Words,
+          typename Enum::_enumerated... Members>
+struct _subset_words;
+
+template <typename Enum, std::size_t... Words,
+          typename Enum::_enumerated... Members>
+struct _subset_words<Enum, _indices<Words...>, Members...> {
+    typedef typename _set_word<Enum::_size_constant>::type  word_type;
+    typedef typename _set_bits<word_type>::type             wide_type;
+
+    constexpr static std::size_t    bits = sizeof(word_type) * CHAR_BIT;
+
+    constexpr static word_type      words[sizeof...(Words)] =
+        { static_cast<word_type>(
+            _subset_bits<wide_type>(
+                bits, Words,
+                _subset_index<Enum>(
+                    Enum(Members)._value, 0, Enum::_size_constant)...))... };
+};
+
+// Before C++17, the words, which are indexed at run time, must also be defined.
+#if __cplusplus < 201703L
+
+template <typename Enum, std::size_t... Words,
+          typename Enum::_enumerated... Members>
+constexpr
+typename _subset_words<Enum, _indices<Words...>, Members...>::word_type
+_subset_words<Enum, _indices<Words...>, Members...>::words[sizeof...(Words)];
+
+#endif
+
+template <typename Enum, typename Enum::_enumerated... Members>
+class subset {
+  private:
+    typedef typename _set_word<Enum::_size_constant>::type  _word;
+    typedef _set_bits<_word>                                _arithmetic;
+    typedef typename _arithmetic::type                      _wide;
+
+    constexpr static std::size_t    _bits = sizeof(_word) * CHAR_BIT;
+    constexpr static std::size_t    _word_count =
+        (Enum::_size_constant + _bits - 1) / _bits;
+
+    typedef
+        _subset_words<Enum, typename _make_indices<_word_count>::type,
+                      Members...>
+        _table;
+
+  public:
+    typedef Enum            value_type;
+    typedef std::size_t     size_type;
+    typedef _word           word_type;
+
+    class const_iterator {
+      public:
+        typedef std::forward_iterator_tag   iterator_category;
+        typedef Enum                        value_type;
+        typedef std::ptrdiff_t              difference_type;
+        typedef const Enum*                 pointer;
+        typedef const Enum&                 reference;
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator() : _index() { }
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ reference operator *() const
+            { return Enum::_values()[_index]; }
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ pointer operator ->() const
+            { return Enum::_values().begin() + _index; }
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator& operator ++()
+        {
+            _index = _next(_index + 1);
+            return *this;
+        }
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ const_iterator operator ++(int)
+        {
+            const_iterator  previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ bool
+        operator ==(const const_iterator &other) const
+            { return _index == other._index; }
+        BETTER_ENUMS_RELAXED_CONSTEXPR_ bool
+        operator !=(const const_iterator &other) const
+            { return _index != other._index; }
+
+      private:
+        explicit BETTER_ENUMS_RELAXED_CONSTEXPR_
+        const_iterator(std::size_t index) : _index(index) { }
+
+        std::size_t     _index;
+
+        friend class subset;
+    };
+
+    typedef const_iterator  iterator;
+
+    constexpr static bool contains(Enum value)
+        { return _contains(value._to_index()); }
+
+    constexpr static size_type size() { return _count(0); }
+    constexpr static bool empty() { return size() == 0; }
+
+    constexpr static const word_type* words() { return _table::words; }
+    constexpr static size_type word_count() { return _word_count; }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static enum_set<Enum> set()
+    {
+        enum_set<Enum>  result;
+
+        for (std::size_t index = 0; index < Enum::_size_constant; ++index) {
+            if (_contains(index))
+                result.insert(Enum::_values()[index]);
+        }
+
+        return result;
+    }
+
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static const_iterator begin()
+        { return const_iterator(_next(0)); }
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static const_iterator end()
+        { return const_iterator(Enum::_size_constant); }
+
+  private:
+    constexpr static bool _contains(std::size_t index)
+        { return ((_table::words[index / _bits] >> (index % _bits)) & 1) != 0; }
+
+    constexpr static std::size_t _count(std::size_t word)
+    {
+        return
+            word == _word_count ? 0 :
+            _arithmetic::popcount(_table::words[word]) + _count(word + 1);
+    }
+
+    // Index of the first member at or after index, or the number of constants.
+    BETTER_ENUMS_RELAXED_CONSTEXPR_ static std::size_t _next(std::size_t index)
+    {
+        std::size_t word = index / _bits;
+        if (word >= _word_count)
+            return Enum::_size_constant;
+
+        _wide remaining =
+            _table::words[word] & (~static_cast<_wide>(0) << (index % _bits));
+
+        while (remaining == 0) {
+            if (++word == _word_count)
+                return Enum::_size_constant;
+
+            remaining = _table::words[word];
+        }
+
+        return word * _bits + _arithmetic::trailing_zeros(remaining);
+    }
+};
+
+}
+
+
+
+#endif // #ifndef BETTER_ENUMS_SUBSET_H
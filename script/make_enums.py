@@ -0,0 +1,300 @@
+#! /usr/bin/env python
+
+# This file is part of Better Enums, released under the BSD 2-clause license.
+# See LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+# You only need this script if the time it takes to compile your enums matters.
+#
+# This script reads a C++ header that declares enums with BETTER_ENUM or
+# SLOW_ENUM, and writes the same header, with each declaration replaced by one
+# that uses the output of this script, rather than the macros of enum.h, for the
+# parts of the enum that are computed from its constants. The names are trimmed
+# and measured here, and the name hash table is filled in here, replicating
+# _name_hash and _fill_buckets in enum.h. The compiler then only has to read
+# them. The enums have the same interface as before. In C++11, their _to_string
+# is constexpr, and, in every mode, they need no initialization, and name lookup
+# uses the hash table.
+#
+# The values are still computed by the compiler, since initializers can be any
+# constant expression, and so is the dense value table built from them.
+#
+# Usage:
+#
+# 0. Move the enum declarations into a header of their own, say enums.in.h,
+#    which includes enum.h, as usual. Anything else in it is copied as it is.
+# 1. Run python make_enums.py enums.in.h > enums.h
+# 2. Include enums.h instead of enums.in.h. It needs the same version of enum.h
+#    as the one this script came with.
+#
+# Declarations in comments, strings, and preprocessor directives are left as
+# they are, so an enum declared inside another macro is not converted.
+
+from __future__ import print_function
+
+import os
+import re
+import sys
+
+DECLARATION_MACROS = ['BETTER_ENUM', 'SLOW_ENUM']
+GENERATED_MACRO = 'BETTER_ENUMS_GENERATED_ENUM'
+
+IDENTIFIER = re.compile(r'[A-Za-z_][A-Za-z0-9_]*')
+
+class ParseError(Exception):
+    pass
+
+# Returns the index just past the comment, string, or character literal that
+# starts at index, or None if there isn't one.
+def skip_literal(text, index):
+    if text.startswith('//', index):
+        end = text.find('\n', index)
+        return len(text) if end == -1 else end
+    if text.startswith('/*', index):
+        end = text.find('*/', index + 2)
+        if end == -1:
+            raise ParseError('unterminated comment')
+        return end + 2
+    if text[index] in '"\'':
+        quote = text[index]
+        index += 1
+        while index < len(text) and text[index] != quote:
+            if text[index] == '\n':
+                raise ParseError('unterminated literal')
+            index += 2 if text[index] == '\\' else 1
+        return index + 1
+    return None
+
+# Splits the arguments of the macro call whose opening parenthesis is at index.
+# Returns the arguments, with comments removed, and the index just past the
+# closing parenthesis.
+def split_arguments(text, index):
+    arguments = []
+    current = []
+    depth = 0
+    index += 1
+
+    while index < len(text):
+        end = skip_literal(text, index)
+        if end is not None:
+            if text[index] in '"\'':
+                current.append(text[index:end])
+            else:
+                current.append(' ')
+            index = end
+            continue
+
+        c = text[index]
+        if c in '([{':
+            depth += 1
+        elif c in ')]}':
+            if depth == 0:
+                arguments.append(''.join(current).strip())
+                return arguments, index + 1
+            depth -= 1
+        elif c == ',' and depth == 0:
+            arguments.append(''.join(current).strip())
+            current = []
+            index += 1
+            continue
+
+        current.append(c)
+        index += 1
+
+    raise ParseError('unterminated macro call')
+
+# Finds each BETTER_ENUM or SLOW_ENUM call outside comments, strings, and
+# directives. Yields the index and text of the macro name, and the arguments and
+# end index, as returned by split_arguments.
+def find_declarations(text):
+    index = 0
+    line_start = True
+    directive = False
+
+    while index < len(text):
+        end = skip_literal(text, index)
+        if end is not None:
+            index = end
+            continue
+
+        c = text[index]
+        if c == '\n':
+            if not (index > 0 and text[index - 1] == '\\'):
+                directive = False
+            line_start = True
+            index += 1
+            continue
+        if c in ' \t\r':
+            index += 1
+            continue
+        if c == '#' and line_start:
+            directive = True
+
+        line_start = False
+
+        match = IDENTIFIER.match(text, index)
+        if match is None:
+            index += 1
+            continue
+        index = match.end()
+
+        if directive or match.group() not in DECLARATION_MACROS:
+            continue
+
+        parenthesis = index
+        while parenthesis < len(text) and text[parenthesis] in ' \t\r\n':
+            parenthesis += 1
+        if parenthesis == len(text) or text[parenthesis] != '(':
+            continue
+
+        arguments, end = split_arguments(text, parenthesis)
+        yield match.start(), match.group(), arguments, end
+        index = end
+
+# Replicates _hash_character and _name_hash in enum.h.
+def name_hash(name, buckets):
+    if len(name) == 0:
+        return 0
+
+    def character(c):
+        return ord(c.lower()) if 'A' <= c <= 'Z' else ord(c)
+
+    length = len(name)
+    return \
+        (((length * 31 + character(name[0])) * 31 +
+            character(name[length // 2])) * 31 +
+            character(name[length - 1])) % buckets
+
+# Replicates _fill_buckets in enum.h.
+def fill_buckets(names):
+    size = len(names)
+    buckets = [size] * (2 * size)
+
+    for index in reversed(range(size)):
+        bucket = name_hash(names[index], size)
+        buckets[2 * index + 1] = buckets[2 * bucket]
+        buckets[2 * bucket] = index
+
+    return buckets
+
+def constant_names(enum, constants):
+    names = []
+    for constant in constants:
+        name = constant.split('=', 1)[0].strip()
+        if IDENTIFIER.match(name) is None or \
+           IDENTIFIER.match(name).end() != len(name):
+            raise ParseError('%s: cannot find the name of "%s"' %
+                             (enum, constant))
+        names.append(name)
+    return names
+
+# Writes prefix followed by the tokens, separated by spaces, wrapped at 80
+# columns. Continued lines are indented by 4 more columns than indent. If
+# backslash is set, continued lines end with a backslash in column 80, as in
+# enum.h, and, if the tokens don't fit on the first line, they all start on the
+# next one.
+def write_wrapped(stream, indent, prefix, tokens, backslash):
+    line = indent + prefix
+    if len(line + ' ' + ' '.join(tokens)) <= 80:
+        print(line + ' ' + ' '.join(tokens), file=stream)
+        return
+
+    limit = 77 if backslash else 80
+    if backslash:
+        print(line.ljust(79) + '\\', file=stream)
+        line = indent + '   '
+
+    for token in tokens:
+        if len(line + ' ' + token) > limit and line.strip() != '':
+            if backslash:
+                print(line.ljust(79) + '\\', file=stream)
+            else:
+                print(line, file=stream)
+            line = indent + '   '
+        line += ' ' + token
+
+    print(line, file=stream)
+
+def listed(items):
+    return [str(item) + ',' for item in items[:-1]] + [str(items[-1])]
+
+# Writes the macros that BETTER_ENUMS_GENERATED reads for one enum.
+def write_tables(stream, indent, enum, names):
+    def macro(part):
+        return 'better_enums_generated_%s_%s' % (enum, part)
+
+    count = len(names)
+    lengths = [len(name) for name in names]
+
+    def write_macro(part, tokens):
+        write_wrapped(stream, indent, '#define ' + macro(part), tokens, True)
+
+    write_macro('count', [str(count)])
+    write_macro('values', listed(['%s::%s' % (enum, name) for name in names]))
+    write_macro('names', listed(['"%s"' % name for name in names]))
+    write_macro('lengths', listed(lengths))
+    write_macro('max_length', [str(max(lengths))])
+    write_macro('buckets', listed(fill_buckets(names)))
+
+    return [macro(part) for part in ['count', 'values', 'names', 'lengths',
+                                     'max_length', 'buckets']]
+
+def generate(stream, text, source, script):
+    print('// This file was automatically generated by ' + script +
+          ' from ' + source, file=stream)
+    print('', file=stream)
+
+    copied = 0
+    for start, name, arguments, end in find_declarations(text):
+        if len(arguments) < 3:
+            raise ParseError('%s needs a name, a type, and constants' % name)
+        arguments = [' '.join(argument.split()) for argument in arguments]
+        enum = arguments[0]
+        names = constant_names(enum, arguments[2:])
+
+        line_start = text.rfind('\n', 0, start) + 1
+        indent = text[line_start:start]
+        if indent.strip() != '':
+            indent = ''
+            stream.write(text[copied:start])
+            print('', file=stream)
+        else:
+            stream.write(text[copied:line_start])
+
+        defined = write_tables(stream, indent, enum, names)
+
+        write_wrapped(stream, indent, GENERATED_MACRO + '(' + enum + ',',
+                      [argument + ',' for argument in arguments[1:-1]] +
+                      [arguments[-1] + ')'], False)
+
+        next_line = text.find('\n', end)
+        rest = text[end:] if next_line == -1 else text[end:next_line]
+        if rest.strip() == '':
+            copied = len(text) if next_line == -1 else next_line + 1
+        else:
+            copied = end
+
+        for macro in defined:
+            print(indent + '#undef ' + macro, file=stream)
+
+    stream.write(text[copied:])
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        print('Usage: ' + sys.argv[0] + ' INPUT > FILE', file=sys.stderr)
+        print('', file=sys.stderr)
+        print('Prints INPUT to FILE, with each enum declaration replaced by',
+              file=sys.stderr)
+        print('one that uses precomputed tables.', file=sys.stderr)
+        sys.exit(1)
+
+    with open(sys.argv[1]) as input:
+        text = input.read()
+
+    try:
+        generate(sys.stdout, text, os.path.basename(sys.argv[1]),
+                 os.path.basename(sys.argv[0]))
+    except ParseError as error:
+        print(sys.argv[1] + ': ' + str(error), file=sys.stderr)
+        sys.exit(1)
+
+    sys.exit(0)
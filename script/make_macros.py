@@ -5,37 +5,42 @@
 
 # You only need this script if you are developing enum.h, or run into a limit.
 #
-# This script generates the macros BETTER_ENUMS_PP_MAP and BETTER_ENUMS_ITERATE,
-# used internally by enum.h. These are already inlined into enum.h.
+# This script generates the macro BETTER_ENUMS_PP_MAP, used internally by
+# enum.h. It is already inlined into enum.h.
 #
 # BETTER_ENUMS_PP_MAP has a limit, which determines the maximum number of
-# constants an enum can have. By default, this limit is 64 constants.
+# constants an enum can have. By default, this limit is 64 constants. The
+# arguments are mapped CHUNK at a time, so the time and memory it takes to
+# preprocess an enum grow about linearly with the number of constants, up to
+# a few thousand.
 #
-# BETTER_ENUMS_ITERATE also has a limit. This one determines the maximum length
-# of the name of a constant that is followed by an initializer (" = 2") when
-# compiling an enum with constexpr _to_string function (i.e. usually, this limit
-# does not apply). By default, the limit is 23 characters (24 with the
-# obligatory null terminator).
-#
-# If either of these limits is inadequate, you can still compile your code
-# without changing enum.h. You need to generate an external macro file with
-# definitions of these macros with relaxed limits, and tell enum.h to use the
-# external macro file. Here is how this is done, supposing you want support for
-# 512 constants of length up to 127 (128 with null terminator):
+# If this limit is inadequate, you can still compile your code without changing
+# enum.h. You need to generate an external macro file with definitions of these
+# macros with a relaxed limit, and tell enum.h to use the external macro file.
+# Here is how this is done, supposing you want support for 512 constants:
 #
 # 0. MACRO_FILE is the name of the external macro file. Make sure you put it
 #    somewhere in your include path.
-# 1. Run python make_macros.py 512 128 > MACRO_FILE
+# 1. Run python make_macros.py 512 > MACRO_FILE
 # 2. Build your code with an additional compiler flag:
 #    - for gcc and clang, -DBETTER_ENUMS_MACRO_FILE='<MACRO_FILE>'
 #    - for VC++, /DBETTER_ENUMS_MACRO_FILE='<MACRO_FILE>'
 #    or use any other method of getting these macros defined.
 # 3. Compile your code. Your macro file should be included, and enum.h should
-#    happily work with whatever limits you chose.
+#    happily work with whatever limit you chose.
+#
+# Earlier versions also took a maximum name length, for names trimmed at
+# compile time. Names no longer have a maximum length, but the argument is still
+# accepted, and ignored, so that existing build scripts keep working.
+
+from __future__ import print_function
 
 import os
 import sys
 
+# Number of arguments taken by each step of BETTER_ENUMS_PP_MAP.
+CHUNK = 16
+
 class MultiLine(object):
     def __init__(self, stream, indent = 4, columns = 80, initial_column = 0):
         self._columns_left = columns - initial_column
@@ -53,7 +58,7 @@ class MultiLine(object):
                 break_line = True
 
         if break_line:
-            print >> self._stream, ' ' * (self._columns_left - 1) + '\\'
+            print(' ' * (self._columns_left - 1) + '\\', file=self._stream)
             self._stream.write(' ' * self._indent)
             self._columns_left = self._columns - self._indent
             token = token.lstrip()
@@ -61,43 +66,92 @@ class MultiLine(object):
         self._stream.write(token)
         self._columns_left -= len(token)
 
-def generate(stream, constants, length, script):
-    print >> stream, '// This file was automatically generated by ' + script
-
-    print >> stream, ''
-    print >> stream, '#pragma once'
-    print >> stream, ''
-    print >> stream, '#ifndef BETTER_ENUMS_MACRO_FILE_H'
-    print >> stream, '#define BETTER_ENUMS_MACRO_FILE_H'
-
-    print >> stream, ''
-    print >> stream, '#define BETTER_ENUMS_PP_MAP(macro, data, ...) \\'
-    print >> stream, '    BETTER_ENUMS_ID( \\'
-    print >> stream, '        BETTER_ENUMS_APPLY( \\'
-    print >> stream, '            BETTER_ENUMS_PP_MAP_VAR_COUNT, \\'
-    print >> stream, '            BETTER_ENUMS_PP_COUNT(__VA_ARGS__)) \\'
-    print >> stream, '        (macro, data, __VA_ARGS__))'
-
-    print >> stream, ''
-    print >> stream, '#define BETTER_ENUMS_PP_MAP_VAR_COUNT(count) ' + \
-                     'BETTER_ENUMS_M ## count'
-
-    print >> stream, ''
-    print >> stream, '#define BETTER_ENUMS_APPLY(macro, ...) ' + \
-                      'BETTER_ENUMS_ID(macro(__VA_ARGS__))'
-
-    print >> stream, ''
-    print >> stream, '#define BETTER_ENUMS_ID(x) x'
-
-    print >> stream, ''
-    print >> stream, '#define BETTER_ENUMS_M1(m, d, x) m(d,0,x)'
-    for index in range(2, constants + 1):
-        print >> stream, '#define BETTER_ENUMS_M' + str(index) + \
-                         '(m,d,x,...) m(d,' + str(index - 1) + ',x) \\'
-        print >> stream, '    BETTER_ENUMS_ID(BETTER_ENUMS_M' + \
-                         str(index - 1) + '(m,d,__VA_ARGS__))'
-
-    print >> stream, ''
+# Name of the macro that applies the macro to the last remaining arguments, a
+# multiple of chunk.
+def chunk_macro(remaining, chunk):
+    if remaining == chunk:
+        return 'BETTER_ENUMS_M%i' % chunk
+    else:
+        return 'BETTER_ENUMS_L%i' % remaining
+
+def generate(stream, constants, script, chunk = CHUNK):
+    print('// This file was automatically generated by ' + script, file=stream)
+
+    print('', file=stream)
+    print('#pragma once', file=stream)
+    print('', file=stream)
+    print('#ifndef BETTER_ENUMS_MACRO_FILE_H', file=stream)
+    print('#define BETTER_ENUMS_MACRO_FILE_H', file=stream)
+
+    print('', file=stream)
+    print('#define BETTER_ENUMS_PP_MAP(macro, data, ...) \\', file=stream)
+    print('    BETTER_ENUMS_ID( \\', file=stream)
+    print('        BETTER_ENUMS_APPLY( \\', file=stream)
+    print('            BETTER_ENUMS_PP_MAP_VAR_COUNT, \\', file=stream)
+    print('            BETTER_ENUMS_PP_COUNT(__VA_ARGS__)) \\', file=stream)
+    print('        (macro, data, __VA_ARGS__))', file=stream)
+
+    print('', file=stream)
+    print('#define BETTER_ENUMS_PP_MAP_VAR_COUNT(count) ' +
+          'BETTER_ENUMS_M ## count', file=stream)
+
+    print('', file=stream)
+    print('#define BETTER_ENUMS_APPLY(macro, ...) ' +
+          'BETTER_ENUMS_ID(macro(__VA_ARGS__))', file=stream)
+
+    print('', file=stream)
+    print('#define BETTER_ENUMS_ID(x) x', file=stream)
+
+    print('', file=stream)
+    # BETTER_ENUMS_Mn applies the macro to n arguments. The arguments are
+    # taken CHUNK at a time, each chunk by a macro that lists its arguments
+    # explicitly, so the arguments that are left are rescanned once per chunk,
+    # rather than once per argument. The indices passed to the macro count down
+    # to 0 from the first argument. They only need to be distinct.
+    #
+    # Up to CHUNK arguments, Mn is a single macro. Otherwise, Mn takes the
+    # first 1 to CHUNK arguments, and hands the rest, a multiple of CHUNK, to
+    # BETTER_ENUMS_Ln. Each Ln takes CHUNK arguments and hands the rest to the
+    # next Ln, until the last CHUNK, which is taken by BETTER_ENUMS_M<CHUNK>.
+    # A macro can't expand to a call of itself, which is why each chunk has its
+    # own macro.
+    for index in range(1, constants + 1):
+        remaining = index - 1 - (index - 1) % chunk
+        taken = index - remaining
+
+        prefix = '#define BETTER_ENUMS_M%i(m, d,' % index
+        stream.write(prefix)
+        definition = MultiLine(stream = stream, indent = 4,
+                               initial_column = len(prefix))
+        for argument in range(1, taken):
+            definition.write(' _%i,' % argument)
+        if remaining > 0:
+            definition.write(' _%i,' % taken)
+            definition.write(' ...)')
+        else:
+            definition.write(' _%i)' % taken)
+        for argument in range(1, taken + 1):
+            definition.write(' m(d, %i, _%i)' % (index - argument, argument))
+        if remaining > 0:
+            definition.write(' BETTER_ENUMS_ID(%s(m, d, __VA_ARGS__))' %
+                             chunk_macro(remaining, chunk), last = True)
+        print('', file=stream)
+
+    for remaining in range(2 * chunk, constants, chunk):
+        prefix = '#define BETTER_ENUMS_L%i(m, d,' % remaining
+        stream.write(prefix)
+        definition = MultiLine(stream = stream, indent = 4,
+                               initial_column = len(prefix))
+        for argument in range(1, chunk + 1):
+            definition.write(' _%i,' % argument)
+        definition.write(' ...)')
+        for argument in range(1, chunk + 1):
+            definition.write(' m(d, %i, _%i)' % (remaining - argument, argument))
+        definition.write(' BETTER_ENUMS_ID(%s(m, d, __VA_ARGS__))' %
+                         chunk_macro(remaining - chunk, chunk), last = True)
+        print('', file=stream)
+
+    print('', file=stream)
     pp_count_impl_prefix = '#define BETTER_ENUMS_PP_COUNT_IMPL(_1,'
     stream.write(pp_count_impl_prefix)
     pp_count_impl = MultiLine(stream = stream, indent = 4,
@@ -107,10 +161,10 @@ def generate(stream, constants, length, script):
     pp_count_impl.write(' count,')
     pp_count_impl.write(' ...)')
     pp_count_impl.write(' count', last = True)
-    print >> stream, ''
+    print('', file=stream)
 
-    print >> stream, ''
-    print >> stream, '#define BETTER_ENUMS_PP_COUNT(...) \\'
+    print('', file=stream)
+    print('#define BETTER_ENUMS_PP_COUNT(...) \\', file=stream)
     pp_count_prefix = \
         '    BETTER_ENUMS_ID(BETTER_ENUMS_PP_COUNT_IMPL(__VA_ARGS__,'
     stream.write(pp_count_prefix)
@@ -119,31 +173,21 @@ def generate(stream, constants, length, script):
     for index in range(0, constants - 1):
         pp_count.write(' ' + str(constants - index) + ',')
     pp_count.write(' 1))', last = True)
-    print >> stream, ''
-
-    print >> stream, ''
-    iterate_prefix = '#define BETTER_ENUMS_ITERATE(X, f, l)'
-    stream.write(iterate_prefix)
-    iterate = MultiLine(stream = stream, indent = 4,
-                        initial_column = len(iterate_prefix))
-    for index in range(0, length):
-        iterate.write(' X(f, l, %i)' % index)
-    print >> stream, ''
+    print('', file=stream)
 
-    print >> stream, ''
-    print >> stream, '#endif // #ifndef BETTER_ENUMS_MACRO_FILE_H'
+    print('', file=stream)
+    print('#endif // #ifndef BETTER_ENUMS_MACRO_FILE_H', file=stream)
 
 if __name__ == '__main__':
-    if len(sys.argv) != 3:
-        print >> sys.stderr, \
-            'Usage: ' + sys.argv[0] + ' CONSTANTS LENGTH > FILE'
-        print >> sys.stderr, ''
-        print >> sys.stderr, 'Prints map macro definition to FILE.'
-        print >> sys.stderr, 'CONSTANTS is the number of constants to support.'
-        print >> sys.stderr, 'LENGTH is the maximum length of a constant name.'
+    if len(sys.argv) not in (2, 3):
+        print('Usage: ' + sys.argv[0] + ' CONSTANTS > FILE',
+              file=sys.stderr)
+        print('', file=sys.stderr)
+        print('Prints map macro definition to FILE.', file=sys.stderr)
+        print('CONSTANTS is the number of constants to support.',
+              file=sys.stderr)
         sys.exit(1)
 
-    generate(sys.stdout, int(sys.argv[1]), int(sys.argv[2]),
-             os.path.basename(sys.argv[0]))
+    generate(sys.stdout, int(sys.argv[1]), os.path.basename(sys.argv[0]))
 
     sys.exit(0)
@@ -0,0 +1,91 @@
+#include <cxxtest/TestSuite.h>
+#include <enum.h>
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+#include <cstring>
+#include <thread>
+#include <better-enums/counters.h>
+
+
+
+BETTER_ENUM(Event, int, Accepted, Rejected = 10, Retried = 20, Dropped = 30)
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+class CounterTests : public CxxTest::TestSuite {
+  public:
+    void test_counters()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        static better_enums::enum_counters<Event, 4>    counters;
+
+        counters.reset();
+        TS_ASSERT_EQUALS(counters.count(Event::Dropped), 0u);
+
+        counters.increment(Event::Dropped);
+        counters.increment(Event::Dropped, 2);
+        counters.increment(Event::Accepted);
+
+        TS_ASSERT_EQUALS(counters.count(Event::Dropped), 3u);
+        TS_ASSERT_EQUALS(counters.count(Event::Accepted), 1u);
+        TS_ASSERT_EQUALS(counters.count(Event::Rejected), 0u);
+
+        better_enums::enum_map<Event, std::uint64_t>    snapshot =
+            counters.snapshot();
+
+        TS_ASSERT_EQUALS(snapshot[Event::Dropped], 3u);
+        TS_ASSERT_EQUALS(strcmp((*snapshot.begin()).first._to_string(),
+                                "Accepted"), 0);
+        TS_ASSERT_EQUALS((*snapshot.begin()).second, 1u);
+
+        counters.reset();
+        TS_ASSERT_EQUALS(counters.count(Event::Dropped), 0u);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_concurrent_increments()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        static better_enums::enum_counters<Event>   counters;
+
+        const std::size_t   threads = 8;
+        const std::size_t   increments = 10000;
+
+        std::thread         workers[threads];
+
+        for (std::size_t thread = 0; thread < threads; ++thread) {
+            workers[thread] = std::thread([&]() {
+                for (std::size_t index = 0; index < increments; ++index) {
+                    counters.increment(Event::Retried);
+                    counters.increment(Event::_values()[index % 2]);
+                }
+            });
+        }
+
+        for (std::size_t thread = 0; thread < threads; ++thread)
+            workers[thread].join();
+
+        TS_ASSERT_EQUALS(counters.count(Event::Retried), threads * increments);
+        TS_ASSERT_EQUALS(counters.count(Event::Accepted),
+                         threads * increments / 2);
+        TS_ASSERT_EQUALS(counters.snapshot()[Event::Rejected],
+                         threads * increments / 2);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_shard_alignment()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        TS_ASSERT_EQUALS(alignof(better_enums::enum_counters<Event>),
+                         static_cast<std::size_t>(
+                             BETTER_ENUMS_CACHE_LINE_SIZE));
+        TS_ASSERT_EQUALS(sizeof(better_enums::enum_counters<Event, 4>),
+                         4u * BETTER_ENUMS_CACHE_LINE_SIZE);
+        TS_ASSERT_EQUALS(sizeof(better_enums::enum_counters<Event>),
+                         64u * BETTER_ENUMS_CACHE_LINE_SIZE);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+};
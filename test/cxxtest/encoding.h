@@ -0,0 +1,90 @@
+#include <cxxtest/TestSuite.h>
+#include <enum.h>
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+#include <better-enums/encoding.h>
+
+
+
+BETTER_ENUM(Opcode, int, Nop, Load = 10, Store, Jump = -1)
+BETTER_ENUM(NarrowOpcode, short, Nop, Load = 10, Store, Jump = -1)
+BETTER_ENUM(Reordered, int, Load = 10, Nop = 0, Store = 11, Jump = -1)
+BETTER_ENUM(Renumbered, int, Nop, Load = 10, Store = 12, Jump = -1)
+BETTER_ENUM(Renamed, int, Nop, Load = 10, Save, Jump = -1)
+
+static_assert(better_enums::fingerprint<Opcode>() ==
+              better_enums::fingerprint<NarrowOpcode>(), "");
+static_assert(better_enums::fingerprint<Opcode>() !=
+              better_enums::fingerprint<Reordered>(), "");
+static_assert(better_enums::fingerprint<Opcode>() !=
+              better_enums::fingerprint<Renumbered>(), "");
+static_assert(better_enums::fingerprint<Opcode>() !=
+              better_enums::fingerprint<Renamed>(), "");
+
+static_assert(better_enums::fixed_width<Opcode>() == 1, "");
+static_assert(better_enums::varint_width<Opcode>() == 1, "");
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+class EncodingTests : public CxxTest::TestSuite {
+  public:
+    void test_fixed()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        unsigned char   bytes[2] = {0xff, 0xff};
+        Opcode          opcode = Opcode::Nop;
+
+        TS_ASSERT_EQUALS(better_enums::encode_fixed(+Opcode::Jump, bytes,
+                                                    bytes + 2),
+                         bytes + 1);
+        TS_ASSERT_EQUALS(bytes[0], 3);
+        TS_ASSERT_EQUALS(bytes[1], 0xff);
+
+        TS_ASSERT_EQUALS(better_enums::decode_fixed(bytes, bytes + 1, opcode),
+                         bytes + 1);
+        TS_ASSERT_EQUALS(opcode, +Opcode::Jump);
+
+        bytes[0] = 4;
+        TS_ASSERT(better_enums::decode_fixed(bytes, bytes + 1, opcode) ==
+                  nullptr);
+        TS_ASSERT(better_enums::decode_fixed(bytes, bytes, opcode) == nullptr);
+        TS_ASSERT(better_enums::encode_fixed(+Opcode::Load, bytes, bytes) ==
+                  nullptr);
+        TS_ASSERT_EQUALS(opcode, +Opcode::Jump);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_varint()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        unsigned char   bytes[2] = {0, 0};
+        Opcode          opcode = Opcode::Nop;
+
+        TS_ASSERT_EQUALS(better_enums::encode_varint(+Opcode::Store, bytes,
+                                                     bytes + 2),
+                         bytes + 1);
+        TS_ASSERT_EQUALS(bytes[0], 2);
+
+        TS_ASSERT_EQUALS(better_enums::decode_varint(bytes, bytes + 2, opcode),
+                         bytes + 1);
+        TS_ASSERT_EQUALS(opcode, +Opcode::Store);
+
+        TS_ASSERT(better_enums::encode_varint(+Opcode::Nop, bytes, bytes) ==
+                  nullptr);
+        TS_ASSERT(better_enums::decode_varint(bytes, bytes, opcode) ==
+                  nullptr);
+
+        bytes[0] = 0x81;
+        TS_ASSERT(better_enums::decode_varint(bytes, bytes + 2, opcode) ==
+                  nullptr);
+
+        bytes[0] = 0x7f;
+        TS_ASSERT(better_enums::decode_varint(bytes, bytes + 2, opcode) ==
+                  nullptr);
+        TS_ASSERT_EQUALS(opcode, +Opcode::Store);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+};
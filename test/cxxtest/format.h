@@ -0,0 +1,93 @@
+#include <cxxtest/TestSuite.h>
+#include <climits>
+#include <cstring>
+#include <enum.h>
+
+#if defined(BETTER_ENUMS_HAVE_CONSTEXPR) && defined(__has_include)
+#   if __has_include(<fmt/format.h>)
+#       define FMT_HEADER_ONLY
+#       include <fmt/format.h>
+#       include <fmt/xchar.h>
+#       define HAVE_FMT
+#   endif
+#endif
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+#   include <better-enums/format.h>
+#endif
+
+
+
+BETTER_ENUM(Signal, short, Hup = 1, Int, Quit, Kill = 9, Term = 15)
+BETTER_ENUM(Nibble, signed char, Zero, Seven = 7)
+
+
+
+class FormatTests : public CxxTest::TestSuite {
+  public:
+    void test_write_name()
+    {
+        char    buffer[8];
+        char    *end;
+
+        end = (+Signal::Kill)._write_to(buffer, buffer + sizeof(buffer));
+        TS_ASSERT_EQUALS(end, buffer + 4);
+        TS_ASSERT_EQUALS(std::memcmp(buffer, "Kill", 4), 0);
+
+        end = (+Signal::Quit)._write_to(buffer, buffer + 4);
+        TS_ASSERT_EQUALS(end, buffer + 4);
+        TS_ASSERT_EQUALS(std::memcmp(buffer, "Quit", 4), 0);
+
+        std::memset(buffer, '.', sizeof(buffer));
+        end = (+Signal::Term)._write_to(buffer, buffer + 3);
+        TS_ASSERT(end == BETTER_ENUMS_NULLPTR);
+        TS_ASSERT_EQUALS(buffer[0], '.');
+    }
+
+    void test_write_integral()
+    {
+        char    buffer[8];
+        char    *end;
+
+        end = Signal::_from_integral_unchecked(42)._write_to(
+            buffer, buffer + sizeof(buffer));
+        TS_ASSERT_EQUALS(end, buffer + 2);
+        TS_ASSERT_EQUALS(std::memcmp(buffer, "42", 2), 0);
+
+        end = Signal::_from_integral_unchecked(0)._write_to(buffer, buffer + 1);
+        TS_ASSERT_EQUALS(end, buffer + 1);
+        TS_ASSERT_EQUALS(buffer[0], '0');
+
+        end = Nibble::_from_integral_unchecked(SCHAR_MIN)._write_to(
+            buffer, buffer + sizeof(buffer));
+        TS_ASSERT_EQUALS(end, buffer + 4);
+        TS_ASSERT_EQUALS(std::memcmp(buffer, "-128", 4), 0);
+
+        end = Nibble::_from_integral_unchecked(-5)._write_to(buffer,
+                                                             buffer + 1);
+        TS_ASSERT(end == BETTER_ENUMS_NULLPTR);
+    }
+
+    void test_fmt()
+    {
+#ifdef HAVE_FMT
+        TS_ASSERT_EQUALS(fmt::format("{}", +Signal::Int), "Int");
+        TS_ASSERT_EQUALS(fmt::format("{:>6}|{:-<5}", +Signal::Hup,
+                                     +Nibble::Seven),
+                         "   Hup|Seven");
+        TS_ASSERT_EQUALS(
+            fmt::format("{}", Signal::_from_integral_unchecked(-7)), "-7");
+        TS_ASSERT(fmt::format(L"{}", +Signal::Term) == L"Term");
+#endif // #ifdef HAVE_FMT
+    }
+
+    void test_std_format()
+    {
+#ifdef __cpp_lib_format
+        TS_ASSERT_EQUALS(std::format("{}", +Signal::Int), "Int");
+        TS_ASSERT_EQUALS(std::format("{:^7}", +Nibble::Zero), " Zero  ");
+        TS_ASSERT(std::format(L"{}", Nibble::_from_integral_unchecked(3)) ==
+                  L"3");
+#endif // #ifdef __cpp_lib_format
+    }
+};
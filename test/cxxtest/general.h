@@ -1,7 +1,9 @@
 #include <iosfwd>
 #include <stdexcept>
+#include <string>
 #include <cxxtest/TestSuite.h>
 #include <enum.h>
+#include <better-enums/batch.h>
 
 #define static_assert_1(e)  static_assert(e, #e)
 
@@ -17,6 +19,30 @@ BETTER_ENUM(Channel, short, Red, Green, Blue)
 BETTER_ENUM(Depth, short, HighColor = 40, TrueColor = 20)
 BETTER_ENUM(Compression, short, None, Huffman, Default = Huffman)
 
+// Dense, but not sequential: looked up through a table.
+BETTER_ENUM(Shuffled, short, Third = 3, First = 1, Second = 2, Fifth = 5,
+            Alias = 1)
+BETTER_ENUM(Octet, unsigned char, Low = 250, Middle = 253, High = 255)
+
+// Sequential, starting below zero.
+BETTER_ENUM(Offset, int, MinusTwo = -2, MinusOne, Zero, One)
+
+// Sparse, with a range that overflows the underlying type.
+BETTER_ENUM(Extremes, int, Lowest = -2147483647 - 1, Highest = 2147483647)
+
+// Names that differ only in case, or only away from their first, middle, and
+// last characters, and so fall into the same name lookup bucket.
+BETTER_ENUM(Spelling, int, Abc, ABC, aBc, AxyzB, AyyyB, Longest = 5, Ab)
+
+// Names longer than a machine word, compared partly a word at a time. Some
+// characters are next to 'A' or 'Z', or differ from other characters only in
+// the bit that case folding sets.
+BETTER_ENUM(Header, int, ContentSecurityPolicy, X_Forwarded_For, Accept_Ranges,
+            Strict_Transport_Security_At_Z)
+
+BETTER_ENUM(Directive, int, Upgrade_Insecure_Requests_Everywhere = 4,
+            Block_All_Mixed_Content, Require_Trusted_Types_For_Script = 1)
+
 
 
 namespace test {
@@ -123,6 +149,28 @@ static_assert_1(
 static_assert_1(Channel::_is_valid("Green"));
 static_assert_1(Channel::_is_valid_nocase("green"));
 
+static_assert_1((+Shuffled::Fifth)._to_index() == 3);
+static_assert_1((+Shuffled::Alias)._to_index() == 1);
+static_assert_1(Shuffled::_from_integral(2) == +Shuffled::Second);
+static_assert_1(!Shuffled::_is_valid((Shuffled::_integral)0));
+static_assert_1(!Shuffled::_is_valid(4));
+static_assert_1(!Shuffled::_is_valid(6));
+static_assert_1((+Octet::High)._to_index() == 2);
+static_assert_1(!Octet::_is_valid(254));
+static_assert_1((+Offset::MinusOne)._to_index() == 1);
+static_assert_1(!Offset::_is_valid(-3));
+static_assert_1(!Offset::_is_valid(2));
+static_assert_1((+Extremes::Highest)._to_index() == 1);
+static_assert_1(!Extremes::_is_valid(0));
+static_assert_1(Spelling::_from_string("aBc") == +Spelling::aBc);
+static_assert_1(Spelling::_from_string_nocase("abc") == +Spelling::Abc);
+static_assert_1(Spelling::_from_string("Longest") == +Spelling::Longest);
+static_assert_1(!Spelling::_is_valid("Longest "));
+static_assert_1(!Spelling::_is_valid("abc"));
+static_assert_1(Channel::_from_string("Greenish", 5) == +Channel::Green);
+static_assert_1(Channel::_is_valid_nocase("GREENISH", 5));
+static_assert_1(!Channel::_is_valid("Green", 4));
+
 static_assert_1(Channel::_size() == 3);
 static_assert_1(Channel::_values().size() == 3);
 static_assert_1(*Channel::_values().begin() == +Channel::Red);
@@ -156,6 +204,11 @@ static_assert_1(Depth::_names().size() == 2);
 static_assert_1(same_string(*Depth::_names().begin(), "HighColor"));
 static_assert_1(same_string(*(Depth::_names().end() - 1), "TrueColor"));
 static_assert_1(same_string(Depth::_names()[0], "HighColor"));
+static_assert_1((+Depth::TrueColor)._name_length() == 9);
+static_assert_1(same_string((+Directive::Upgrade_Insecure_Requests_Everywhere)
+                                ._to_string(),
+                            "Upgrade_Insecure_Requests_Everywhere"));
+static_assert_1(Directive::_names()[2][32] == '\0');
 
 #endif // #ifdef BETTER_ENUMS_CONSTEXPR_TO_STRING
 
@@ -347,6 +400,194 @@ class EnumTests : public CxxTest::TestSuite {
         TS_ASSERT_EQUALS((+Compression::None)._to_index(), 0);
         TS_ASSERT_EQUALS((+Compression::Huffman)._to_index(), 1);
 //        TS_ASSERT_EQUALS((+Compression::Default)._to_index(), 2); // This won't pass as Compression::Huffman == Compression::Default
+    }
+
+    void test_dense_lookup()
+    {
+        TS_ASSERT_EQUALS((+Shuffled::Third)._to_index(), 0);
+        TS_ASSERT_EQUALS((+Shuffled::First)._to_index(), 1);
+        TS_ASSERT_EQUALS((+Shuffled::Second)._to_index(), 2);
+        TS_ASSERT_EQUALS((+Shuffled::Fifth)._to_index(), 3);
+        TS_ASSERT_EQUALS((+Shuffled::Alias)._to_index(), 1);
+        TS_ASSERT_EQUALS(strcmp((+Shuffled::Fifth)._to_string(), "Fifth"), 0);
+        TS_ASSERT_EQUALS(strcmp((+Shuffled::Alias)._to_string(), "First"), 0);
+
+        TS_ASSERT_EQUALS(Shuffled::_from_integral(5), +Shuffled::Fifth);
+        TS_ASSERT(!Shuffled::_from_integral_nothrow(0));
+        TS_ASSERT(!Shuffled::_from_integral_nothrow(4));
+        TS_ASSERT(!Shuffled::_from_integral_nothrow(6));
+        TS_ASSERT(!Shuffled::_from_integral_nothrow(-1));
+        TS_ASSERT(!Shuffled::_from_integral_nothrow(255));
+
+        TS_ASSERT_EQUALS((+Octet::Middle)._to_index(), 1);
+        TS_ASSERT_EQUALS(strcmp((+Octet::High)._to_string(), "High"), 0);
+        TS_ASSERT(!Octet::_is_valid((Octet::_integral)0));
+        TS_ASSERT(!Octet::_is_valid(251));
+
+        TS_ASSERT_EQUALS((+Offset::MinusTwo)._to_index(), 0);
+        TS_ASSERT_EQUALS((+Offset::One)._to_index(), 3);
+        TS_ASSERT_EQUALS(Offset::_from_integral(0), +Offset::Zero);
+        TS_ASSERT_EQUALS(strcmp((+Offset::MinusOne)._to_string(), "MinusOne"),
+                         0);
+        TS_ASSERT(!Offset::_is_valid(-3));
+        TS_ASSERT(!Offset::_is_valid(2));
+    }
+
+    void test_sparse_lookup()
+    {
+        TS_ASSERT_EQUALS((+Extremes::Lowest)._to_index(), 0);
+        TS_ASSERT_EQUALS((+Extremes::Highest)._to_index(), 1);
+        TS_ASSERT_EQUALS(strcmp((+Extremes::Highest)._to_string(), "Highest"),
+                         0);
+        TS_ASSERT(!Extremes::_is_valid(0));
+        TS_ASSERT(!Extremes::_is_valid(-1));
+    }
+
+    void test_name_lookup()
+    {
+        TS_ASSERT_EQUALS(Spelling::_from_string("Abc"), +Spelling::Abc);
+        TS_ASSERT_EQUALS(Spelling::_from_string("ABC"), +Spelling::ABC);
+        TS_ASSERT_EQUALS(Spelling::_from_string("aBc"), +Spelling::aBc);
+        TS_ASSERT_EQUALS(Spelling::_from_string("AxyzB"), +Spelling::AxyzB);
+        TS_ASSERT_EQUALS(Spelling::_from_string("AyyyB"), +Spelling::AyyyB);
+        TS_ASSERT_EQUALS(Spelling::_from_string("Longest"), +Spelling::Longest);
+        TS_ASSERT_EQUALS(Spelling::_from_string("Ab"), +Spelling::Ab);
+        TS_ASSERT(!Spelling::_from_string_nothrow("abc"));
+        TS_ASSERT(!Spelling::_from_string_nothrow("AxxxB"));
+        TS_ASSERT(!Spelling::_from_string_nothrow("Longest = 5"));
+        TS_ASSERT(!Spelling::_from_string_nothrow("LongestName"));
+        TS_ASSERT(!Spelling::_from_string_nothrow("A"));
+        TS_ASSERT(!Spelling::_from_string_nothrow(""));
+
+        TS_ASSERT_EQUALS(Spelling::_from_string_nocase("abc"), +Spelling::Abc);
+        TS_ASSERT_EQUALS(Spelling::_from_string_nocase("ABC"), +Spelling::Abc);
+        TS_ASSERT_EQUALS(Spelling::_from_string_nocase("ayyyb"),
+                         +Spelling::AyyyB);
+        TS_ASSERT_EQUALS(Spelling::_from_string_nocase("LONGEST"),
+                         +Spelling::Longest);
+        TS_ASSERT(!Spelling::_from_string_nocase_nothrow("axxxb"));
+        TS_ASSERT(!Spelling::_from_string_nocase_nothrow("longestname"));
+    }
+
+    void test_long_name_lookup()
+    {
+        TS_ASSERT_EQUALS(Header::_from_string("ContentSecurityPolicy"),
+                         +Header::ContentSecurityPolicy);
+        TS_ASSERT_EQUALS(Header::_from_string_nocase("contentsecuritypolicy"),
+                         +Header::ContentSecurityPolicy);
+        TS_ASSERT_EQUALS(Header::_from_string_nocase("CONTENTSECURITYPOLICY"),
+                         +Header::ContentSecurityPolicy);
+        TS_ASSERT_EQUALS(Header::_from_string_nocase("x_forwarded_FOR"),
+                         +Header::X_Forwarded_For);
+        TS_ASSERT_EQUALS(
+            Header::_from_string_nocase("STRICT_TRANSPORT_SECURITY_at_z"),
+            +Header::Strict_Transport_Security_At_Z);
+
+        TS_ASSERT_EQUALS(
+            strcmp((+Directive::Upgrade_Insecure_Requests_Everywhere)
+                       ._to_string(),
+                   "Upgrade_Insecure_Requests_Everywhere"), 0);
+        TS_ASSERT_EQUALS(
+            Directive::_from_string("Require_Trusted_Types_For_Script"),
+            +Directive::Require_Trusted_Types_For_Script);
+
+        TS_ASSERT(!Header::_from_string_nothrow("contentSecurityPolicy"));
+        TS_ASSERT(!Header::_from_string_nothrow("ContentSecurityPolicY"));
+        TS_ASSERT(!Header::_from_string_nocase_nothrow(
+            "ContentSecurityPolicx"));
+        TS_ASSERT(!Header::_from_string_nocase_nothrow(
+            "ContentSecurit@Policy"));
+        TS_ASSERT(!Header::_from_string_nocase_nothrow(
+            "ContentSecurity[olicy"));
+        TS_ASSERT(!Header::_from_string_nocase_nothrow(
+            "X\x7f" "Forwarded_For"));
+        TS_ASSERT(!Header::_from_string_nocase_nothrow("\xc1" "ccept_Ranges"));
+        TS_ASSERT(!Header::_from_string_nocase_nothrow("\xe1" "ccept_Ranges"));
+        TS_ASSERT_EQUALS(Header::_from_string_nocase("accept_ranges"),
+                         +Header::Accept_Ranges);
+        TS_ASSERT(!Header::_from_string_nocase_nothrow(
+            "Strict_Transport_Security_At_\xda"));
+        TS_ASSERT(!Header::_from_string_nocase_nothrow(
+            "Strict_Transport_Security_At_\xfa"));
+        TS_ASSERT(!Header::_from_string_nocase_nothrow(
+            "Strict_Transport_Security_At_["));
+        TS_ASSERT(!Header::_from_string_nocase_nothrow(
+            "Strict_Transport_Security@At_Z"));
+
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+        static_assert(Header::_from_string_nocase("CONTENTsecurityPOLICY") ==
+                      +Header::ContentSecurityPolicy, "");
+        static_assert(
+            !Header::_from_string_nocase_nothrow("ContentSecurit@Policy"), "");
+#endif // #ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+    }
+
+    void test_length_lookup()
+    {
+        const char  buffer[] = "GreenBlueabcLongest";
+
+        TS_ASSERT_EQUALS(Channel::_from_string(buffer, 5), +Channel::Green);
+        TS_ASSERT_EQUALS(Channel::_from_string(buffer + 5, 4), +Channel::Blue);
+        TS_ASSERT_EQUALS(Channel::_from_string_nocase(buffer, 5),
+                         +Channel::Green);
+        TS_ASSERT_THROWS(Channel::_from_string(buffer, 4), std::runtime_error);
+        TS_ASSERT_THROWS(Channel::_from_string(buffer, 6), std::runtime_error);
+        TS_ASSERT_THROWS(Channel::_from_string_nocase(buffer, 0),
+                         std::runtime_error);
+
+        TS_ASSERT(Channel::_from_string_nothrow(buffer + 5, 4));
+        TS_ASSERT(!Channel::_from_string_nothrow(buffer + 5, 3));
+        TS_ASSERT(Channel::_from_string_nocase_nothrow(buffer + 5, 4));
+        TS_ASSERT(!Channel::_from_string_nocase_nothrow(buffer, 9));
+
+        TS_ASSERT(Spelling::_is_valid(buffer + 12, 7));
+        TS_ASSERT(!Spelling::_is_valid(buffer + 9, 3));
+        TS_ASSERT(Spelling::_is_valid_nocase(buffer + 9, 3));
+        TS_ASSERT_EQUALS(Spelling::_from_string_nocase(buffer + 9, 3),
+                         +Spelling::Abc);
+
+        const char  embedded[] = { 'G', 'r', 'e', 'e', 'n', '\0', 'x' };
+        TS_ASSERT(Channel::_is_valid(embedded, 5));
+        TS_ASSERT(!Channel::_is_valid(embedded, 6));
+        TS_ASSERT(!Channel::_is_valid(embedded, 7));
+    }
+
+    void test_string_view_lookup()
+    {
+#ifdef BETTER_ENUMS_HAVE_STRING_VIEW
+        std::string_view    view("Blue and Green");
+
+        TS_ASSERT_EQUALS(Channel::_from_string(view.substr(0, 4)),
+                         +Channel::Blue);
+        TS_ASSERT_EQUALS(Channel::_from_string_nocase(view.substr(9)),
+                         +Channel::Green);
+        TS_ASSERT(Channel::_from_string_nothrow(view.substr(9)));
+        TS_ASSERT(!Channel::_from_string_nothrow(view));
+        TS_ASSERT(Channel::_from_string_nocase_nothrow(view.substr(0, 4)));
+        TS_ASSERT(Channel::_is_valid(view.substr(0, 4)));
+        TS_ASSERT(!Channel::_is_valid(view.substr(0, 3)));
+        TS_ASSERT(Channel::_is_valid_nocase(view.substr(9)));
+        TS_ASSERT(Channel::_is_valid(std::string("Red")));
+#endif // #ifdef BETTER_ENUMS_HAVE_STRING_VIEW
+    }
+
+    void test_name_length()
+    {
+        TS_ASSERT_EQUALS((+Channel::Red)._name_length(), 3u);
+        TS_ASSERT_EQUALS((+Channel::Green)._name_length(), 5u);
+        TS_ASSERT_EQUALS((+Depth::HighColor)._name_length(), 9u);
+        TS_ASSERT_EQUALS((+Spelling::Longest)._name_length(), 7u);
+        TS_ASSERT_EQUALS((+Spelling::Ab)._name_length(), 2u);
+        TS_ASSERT_EQUALS(Channel::_name_length(1), 5u);
+        TS_ASSERT_EQUALS(Compression::_name_length(2), 7u);
+        TS_ASSERT_EQUALS(Spelling::_name_length(6), 2u);
+
+#ifdef BETTER_ENUMS_HAVE_STRING_VIEW
+        TS_ASSERT_EQUALS((+Channel::Blue)._to_string_view(), "Blue");
+        TS_ASSERT_EQUALS((+Spelling::Longest)._to_string_view(), "Longest");
+        TS_ASSERT_EQUALS((+Spelling::Longest)._to_string_view().data(),
+                         (+Spelling::Longest)._to_string());
+#endif // #ifdef BETTER_ENUMS_HAVE_STRING_VIEW
     }
 
 	void test_from_index()
@@ -424,6 +665,93 @@ class EnumTests : public CxxTest::TestSuite {
         TS_ASSERT_EQUALS((+Compression::Huffman), Compression::_from_index_unchecked(1));
         TS_ASSERT_EQUALS((+Compression::Default), Compression::_from_index_unchecked(2));
 	}
+
+    void test_from_integral_batch()
+    {
+        const int   offsets[] = {-3, -2, 1, 2, 0, -1};
+        Offset      offset_results[6] =
+            {Offset::One, Offset::One, Offset::One, Offset::One, Offset::One,
+             Offset::One};
+        bool        ok[6];
+
+        TS_ASSERT_EQUALS(
+            better_enums::from_integral_batch(offsets, 6, offset_results, ok),
+            4u);
+        TS_ASSERT(!ok[0]);
+        TS_ASSERT_EQUALS(offset_results[0], +Offset::MinusTwo);
+        TS_ASSERT(ok[1]);
+        TS_ASSERT_EQUALS(offset_results[1], +Offset::MinusTwo);
+        TS_ASSERT(ok[2]);
+        TS_ASSERT_EQUALS(offset_results[2], +Offset::One);
+        TS_ASSERT(!ok[3]);
+        TS_ASSERT_EQUALS(offset_results[4], +Offset::Zero);
+        TS_ASSERT_EQUALS(offset_results[5], +Offset::MinusOne);
+
+        const unsigned char octets[] = {255, 254, 250};
+        Octet               octet_results[3] =
+            {Octet::High, Octet::High, Octet::High};
+
+        TS_ASSERT_EQUALS(
+            better_enums::from_integral_batch(octets, 3, octet_results, ok),
+            2u);
+        TS_ASSERT(ok[0]);
+        TS_ASSERT_EQUALS(octet_results[0], +Octet::High);
+        TS_ASSERT(!ok[1]);
+        TS_ASSERT_EQUALS(octet_results[1], +Octet::Low);
+        TS_ASSERT(ok[2]);
+        TS_ASSERT_EQUALS(octet_results[2], +Octet::Low);
+
+        const short     compressions[] = {1, 2};
+        Compression     compression_results[2] =
+            {Compression::None, Compression::None};
+
+        TS_ASSERT_EQUALS(
+            better_enums::from_integral_batch(compressions, 2,
+                                              compression_results, ok),
+            1u);
+        TS_ASSERT(ok[0]);
+        TS_ASSERT_EQUALS(compression_results[0], +Compression::Huffman);
+        TS_ASSERT(!ok[1]);
+    }
+
+    void test_to_index_batch()
+    {
+        const Offset    offsets[] = {Offset::One, Offset::MinusTwo};
+        const Shuffled  shuffled[] =
+            {Shuffled::Fifth, Shuffled::Alias, Shuffled::Third};
+        std::size_t     indices[3];
+
+        better_enums::to_index_batch(offsets, 2, indices);
+        TS_ASSERT_EQUALS(indices[0], 3u);
+        TS_ASSERT_EQUALS(indices[1], 0u);
+
+        better_enums::to_index_batch(shuffled, 3, indices);
+        TS_ASSERT_EQUALS(indices[0], 3u);
+        TS_ASSERT_EQUALS(indices[1], 1u);
+        TS_ASSERT_EQUALS(indices[2], 0u);
+    }
+
+    void test_from_string_batch()
+    {
+        const char          *column = "GreenRedBluish";
+        const char          *names[] = {column, column + 5, column + 8, "Blue"};
+        const std::size_t   lengths[] = {5, 3, 4, 4};
+        Channel             results[4] =
+            {Channel::Blue, Channel::Blue, Channel::Blue, Channel::Green};
+        bool                ok[4];
+
+        TS_ASSERT_EQUALS(
+            better_enums::from_string_batch(names, lengths, 4, results, ok),
+            3u);
+        TS_ASSERT(ok[0]);
+        TS_ASSERT_EQUALS(results[0], +Channel::Green);
+        TS_ASSERT(ok[1]);
+        TS_ASSERT_EQUALS(results[1], +Channel::Red);
+        TS_ASSERT(!ok[2]);
+        TS_ASSERT_EQUALS(results[2], +Channel::Red);
+        TS_ASSERT(ok[3]);
+        TS_ASSERT_EQUALS(results[3], +Channel::Blue);
+    }
 };
 
 
@@ -431,4 +759,7 @@ class EnumTests : public CxxTest::TestSuite {
 BETTER_ENUM(InternalNameCollisions, int,
             EnumClassForSwitchStatements, PutNamesInThisScopeAlso,
             force_initialization, value_array, raw_names, name_storage,
-            name_array, initialized, the_raw_names, the_name_array)
+            name_array, initialized, the_raw_names, the_name_array,
+            sequential, shape, dense_index, dense_table, name_index,
+            name_table, name_buckets, name_lengths, the_name_lengths,
+            trimmed_names)
@@ -0,0 +1,81 @@
+#include <cxxtest/TestSuite.h>
+#include <cstring>
+#include <enum.h>
+
+#include "generated/enums.h"
+
+BETTER_ENUM(DeclaredPalette, int, Red = 1, Green, Blue, Magenta = 10,
+                                  Fuchsia = Magenta, Ultramarine = 40)
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+static_assert(Palette::_size() == 6, "");
+static_assert(Palette::_max_name_length() == 11, "");
+static_assert((+Palette::Blue)._name_length() == 4, "");
+static_assert(Palette::_from_string("Blue") == +Palette::Blue, "");
+static_assert(Palette::_from_string_nocase("fuchsia") == +Palette::Magenta,
+              "");
+static_assert(!Palette::_from_string_nothrow("Ultra"), "");
+static_assert(Palette::_from_integral(2) == +Palette::Green, "");
+static_assert(better_enums::fingerprint<Palette>() ==
+              better_enums::fingerprint<DeclaredPalette>(), "");
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+class GeneratedTests : public CxxTest::TestSuite {
+  public:
+    void test_same_as_declared()
+    {
+        TS_ASSERT_EQUALS(Palette::_size(), DeclaredPalette::_size());
+
+        for (std::size_t index = 0; index < Palette::_size(); ++index) {
+            Palette         generated = Palette::_from_index(index);
+            DeclaredPalette declared = DeclaredPalette::_from_index(index);
+
+            TS_ASSERT_EQUALS(generated._to_integral(), declared._to_integral());
+            TS_ASSERT_EQUALS(generated._to_index(), declared._to_index());
+            TS_ASSERT_EQUALS(strcmp(generated._to_string(),
+                                    declared._to_string()), 0);
+            TS_ASSERT_EQUALS(generated._name_length(),
+                             declared._name_length());
+
+            TS_ASSERT_EQUALS(
+                Palette::_from_string(Palette::_names()[index])._to_integral(),
+                declared._to_integral());
+        }
+    }
+
+    void test_names()
+    {
+        TS_ASSERT_EQUALS(strcmp((+Palette::Ultramarine)._to_string(),
+                                "Ultramarine"), 0);
+        TS_ASSERT_EQUALS((+Palette::Fuchsia)._to_string(),
+                         (+Palette::Magenta)._to_string());
+        TS_ASSERT_EQUALS(Palette::_from_string("Fuchsia"), +Palette::Magenta);
+        TS_ASSERT_EQUALS(Palette::_from_string("Redder", 3), +Palette::Red);
+        TS_ASSERT(!Palette::_from_string_nothrow("Green", 3));
+        TS_ASSERT(!Palette::_from_string_nothrow("Ultramarines"));
+        TS_ASSERT(!Palette::_from_string_nothrow(""));
+    }
+
+    void test_namespaced()
+    {
+        TS_ASSERT_EQUALS(generated::Weekday::_size(), 7u);
+        TS_ASSERT_EQUALS(
+            generated::Weekday::_from_string_nocase("SUNDAY"),
+            +generated::Weekday::Sunday);
+        TS_ASSERT_EQUALS(strcmp((+generated::Weekday::Wednesday)._to_string(),
+                                "Wednesday"), 0);
+        TS_ASSERT_EQUALS(generated::Weekday::_max_name_length(), 9u);
+
+        for (std::size_t index = 0; index < generated::Weekday::_size();
+             ++index) {
+
+            generated::Weekday  day = generated::Weekday::_values()[index];
+            TS_ASSERT_EQUALS(
+                generated::Weekday::_from_string(day._to_string()), day);
+        }
+    }
+};
@@ -0,0 +1,56 @@
+// This file was automatically generated by make_enums.py from enums.in.h
+
+// Input to script/make_enums.py, which writes enums.h, the header included by
+// generated.h. Regenerate it from the root of the repository after changing
+// this file:
+//
+//     python script/make_enums.py test/cxxtest/generated/enums.in.h >
+//         test/cxxtest/generated/enums.h
+//
+// BETTER_ENUM(Commented, int, Ignored) is left as it is.
+
+#pragma once
+
+#include <enum.h>
+
+#define better_enums_generated_Palette_count 6
+#define better_enums_generated_Palette_values                                  \
+    Palette::Red, Palette::Green, Palette::Blue, Palette::Magenta,             \
+    Palette::Fuchsia, Palette::Ultramarine
+#define better_enums_generated_Palette_names                                   \
+    "Red", "Green", "Blue", "Magenta", "Fuchsia", "Ultramarine"
+#define better_enums_generated_Palette_lengths 3, 5, 4, 7, 7, 11
+#define better_enums_generated_Palette_max_length 11
+#define better_enums_generated_Palette_buckets                                 \
+    0, 6, 1, 6, 2, 3, 6, 5, 4, 6, 6, 6
+BETTER_ENUMS_GENERATED_ENUM(Palette, int, Red = 1, Green, Blue, Magenta = 10,
+    Fuchsia = Magenta, Ultramarine = 40)
+#undef better_enums_generated_Palette_count
+#undef better_enums_generated_Palette_values
+#undef better_enums_generated_Palette_names
+#undef better_enums_generated_Palette_lengths
+#undef better_enums_generated_Palette_max_length
+#undef better_enums_generated_Palette_buckets
+
+namespace generated {
+    #define better_enums_generated_Weekday_count 7
+    #define better_enums_generated_Weekday_values                              \
+        Weekday::Monday, Weekday::Tuesday, Weekday::Wednesday,                 \
+        Weekday::Thursday, Weekday::Friday, Weekday::Saturday,                 \
+        Weekday::Sunday
+    #define better_enums_generated_Weekday_names                               \
+        "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday",    \
+        "Sunday"
+    #define better_enums_generated_Weekday_lengths 6, 7, 9, 8, 6, 8, 6
+    #define better_enums_generated_Weekday_max_length 9
+    #define better_enums_generated_Weekday_buckets                             \
+        7, 4, 6, 7, 2, 7, 0, 7, 3, 7, 1, 7, 5, 7
+    BETTER_ENUMS_GENERATED_ENUM(Weekday, char, Monday, Tuesday, Wednesday,
+        Thursday, Friday, Saturday, Sunday)
+    #undef better_enums_generated_Weekday_count
+    #undef better_enums_generated_Weekday_values
+    #undef better_enums_generated_Weekday_names
+    #undef better_enums_generated_Weekday_lengths
+    #undef better_enums_generated_Weekday_max_length
+    #undef better_enums_generated_Weekday_buckets
+}
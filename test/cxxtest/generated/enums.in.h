@@ -0,0 +1,20 @@
+// Input to script/make_enums.py, which writes enums.h, the header included by
+// generated.h. Regenerate it from the root of the repository after changing
+// this file:
+//
+//     python script/make_enums.py test/cxxtest/generated/enums.in.h >
+//         test/cxxtest/generated/enums.h
+//
+// BETTER_ENUM(Commented, int, Ignored) is left as it is.
+
+#pragma once
+
+#include <enum.h>
+
+BETTER_ENUM(Palette, int, Red = 1, Green, Blue, Magenta = 10,
+                          Fuchsia = Magenta, Ultramarine = 40)
+
+namespace generated {
+    SLOW_ENUM(Weekday, char, Monday, Tuesday, Wednesday, Thursday, Friday,
+                             Saturday, Sunday)
+}
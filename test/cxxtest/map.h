@@ -0,0 +1,211 @@
+#include <cxxtest/TestSuite.h>
+#include <cstring>
+#include <string>
+#include <enum.h>
+#include <better-enums/enum_map.h>
+#include <better-enums/sorted_map.h>
+#include <better-enums/static_map.h>
+
+
+
+BETTER_ENUM(Protocol, int, Http = 80, Ssh = 22, Smtp = 25, Dns = 53, Ftp = 21,
+                           Telnet = 23, Https = 443)
+
+BETTER_ENUMS_CONSTEXPR_ int wire_code(Protocol protocol)
+{
+    return protocol._to_integral() * 10 + 1;
+}
+
+BETTER_ENUMS_CONSTEXPR_ const char* label(Protocol protocol)
+{
+    return
+        protocol == +Protocol::Http ? "web" :
+        protocol == +Protocol::Https ? "web" :
+        protocol == +Protocol::Smtp ? "mail" :
+        "other";
+}
+
+struct reverse_alphabetical {
+    BETTER_ENUMS_CONSTEXPR_ static bool less(const char *a, const char *b)
+        { return better_enums::map_compare<const char*>::less(b, a); }
+};
+
+
+
+class MapTests : public CxxTest::TestSuite {
+  public:
+    void test_map()
+    {
+        better_enums::map<Protocol, int>    codes =
+            better_enums::make_map(wire_code);
+
+        TS_ASSERT_EQUALS(codes[Protocol::Ssh], 221);
+        TS_ASSERT_EQUALS(codes.from_enum(Protocol::Http), 801);
+        TS_ASSERT_EQUALS(codes.to_enum(531), +Protocol::Dns);
+        TS_ASSERT(!codes.to_enum_nothrow(532));
+        TS_ASSERT_THROWS(codes.to_enum(0), std::runtime_error);
+    }
+
+    void test_sorted_map()
+    {
+        better_enums::sorted_map<Protocol, int> codes =
+            better_enums::make_sorted_map(wire_code);
+
+        for (std::size_t index = 0; index < Protocol::_size(); ++index) {
+            Protocol    protocol = Protocol::_values()[index];
+
+            TS_ASSERT_EQUALS(codes[protocol], wire_code(protocol));
+            TS_ASSERT_EQUALS(codes.from_enum(protocol), wire_code(protocol));
+            TS_ASSERT_EQUALS(codes.to_enum(wire_code(protocol)), protocol);
+            TS_ASSERT(!codes.to_enum_nothrow(wire_code(protocol) + 1));
+        }
+
+        TS_ASSERT(!codes.to_enum_nothrow(0));
+        TS_ASSERT(!codes.to_enum_nothrow(100000));
+        TS_ASSERT_THROWS(codes.to_enum(0), std::runtime_error);
+    }
+
+    void test_sorted_map_strings()
+    {
+        better_enums::sorted_map<Protocol, const char*> labels =
+            better_enums::make_sorted_map(label);
+
+        TS_ASSERT_EQUALS(strcmp(labels[Protocol::Smtp], "mail"), 0);
+        TS_ASSERT_EQUALS(labels.to_enum("mail"), +Protocol::Smtp);
+        TS_ASSERT(!labels.to_enum_nothrow("gopher"));
+
+        std::string web("web");
+        TS_ASSERT_EQUALS(labels.to_enum(web.c_str()), +Protocol::Http);
+        TS_ASSERT_EQUALS(labels.to_enum("other"), +Protocol::Ssh);
+    }
+
+    void test_sorted_map_compare()
+    {
+        better_enums::sorted_map<Protocol, const char*, reverse_alphabetical>
+            labels(label);
+
+        TS_ASSERT_EQUALS(labels.to_enum("web"), +Protocol::Http);
+        TS_ASSERT(!labels.to_enum_nothrow("gopher"));
+    }
+
+    void test_static_map()
+    {
+        typedef better_enums::static_map<Protocol, int, wire_code>  Codes;
+
+        Codes   codes;
+
+        TS_ASSERT_EQUALS(codes[Protocol::Telnet], 231);
+        TS_ASSERT_EQUALS(Codes::from_enum(Protocol::Https), 4431);
+        TS_ASSERT_EQUALS(Codes::to_enum(251), +Protocol::Smtp);
+        TS_ASSERT(!Codes::to_enum_nothrow(250));
+        TS_ASSERT_THROWS(Codes::to_enum(0), std::runtime_error);
+
+        typedef better_enums::static_map<Protocol, const char*, label,
+                                         reverse_alphabetical>  Labels;
+
+        TS_ASSERT_EQUALS(Labels::to_enum("mail"), +Protocol::Smtp);
+        TS_ASSERT_EQUALS(Labels::to_enum("other"), +Protocol::Ssh);
+        TS_ASSERT(!Labels::to_enum_nothrow("gopher"));
+    }
+
+    void test_make_static_map()
+    {
+#ifdef BETTER_ENUMS_HAVE_AUTO_TEMPLATE_PARAMETER
+        constexpr auto  labels = better_enums::make_static_map<label>();
+
+        static_assert(labels[Protocol::Https][0] == 'w', "");
+        static_assert(labels.to_enum("web") == +Protocol::Http, "");
+        TS_ASSERT_EQUALS(labels.to_enum("mail"), +Protocol::Smtp);
+#endif // #ifdef BETTER_ENUMS_HAVE_AUTO_TEMPLATE_PARAMETER
+    }
+
+    void test_enum_map()
+    {
+        better_enums::enum_map<Protocol, int>   counts;
+
+        TS_ASSERT_EQUALS(counts.size(), Protocol::_size());
+        TS_ASSERT_EQUALS(counts[Protocol::Ftp], 0);
+
+        ++counts[Protocol::Ftp];
+        counts[Protocol::Https] += 2;
+
+        TS_ASSERT_EQUALS(counts[Protocol::Ftp], 1);
+        TS_ASSERT_EQUALS(counts[Protocol::Https], 2);
+        TS_ASSERT_EQUALS(counts.begin()[Protocol(Protocol::Https)._to_index()]
+                            .second, 2);
+
+        counts.fill(7);
+        TS_ASSERT_EQUALS(counts[Protocol::Ftp], 7);
+
+        const better_enums::enum_map<Protocol, int> filled(3);
+        TS_ASSERT_EQUALS(filled[Protocol::Dns], 3);
+
+        const better_enums::enum_map<Protocol, const char*> labels(label);
+        TS_ASSERT_EQUALS(strcmp(labels[Protocol::Smtp], "mail"), 0);
+    }
+
+    void test_enum_map_iteration()
+    {
+        better_enums::enum_map<Protocol, int>   codes(wire_code);
+
+        std::size_t index = 0;
+        for (better_enums::enum_map<Protocol, int>::iterator entry =
+                codes.begin(); entry != codes.end(); ++entry, ++index) {
+
+            TS_ASSERT_EQUALS((*entry).first, Protocol::_values()[index]);
+            TS_ASSERT_EQUALS((*entry).second, wire_code((*entry).first));
+
+            (*entry).second = 0;
+        }
+        TS_ASSERT_EQUALS(index, Protocol::_size());
+        TS_ASSERT_EQUALS(codes[Protocol::Telnet], 0);
+
+        const better_enums::enum_map<Protocol, int> &constant = codes;
+        better_enums::enum_map<Protocol, int>::const_iterator entry =
+            constant.begin();
+
+        TS_ASSERT_EQUALS((*entry++).first, +Protocol::Http);
+        TS_ASSERT_EQUALS(entry->first, +Protocol::Ssh);
+        TS_ASSERT_EQUALS(entry->second, 0);
+    }
+
+    void test_enum_map_range_for()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        better_enums::enum_map<Protocol, int>   codes(wire_code);
+
+        std::size_t index = 0;
+        for (auto &entry : codes) {
+            TS_ASSERT_EQUALS(entry.first, Protocol::_values()[index++]);
+            entry.second = -entry.second;
+        }
+        TS_ASSERT_EQUALS(codes[Protocol::Smtp], -wire_code(Protocol::Smtp));
+
+        const better_enums::enum_map<Protocol, int> &constant = codes;
+        for (const auto &entry : constant)
+            TS_ASSERT_EQUALS(entry.second, -wire_code(entry.first));
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_constexpr_enum_map()
+    {
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+        constexpr better_enums::enum_map<Protocol, int> codes(wire_code);
+
+        static_assert(codes[Protocol::Ssh] == 221, "");
+        static_assert((*codes.begin()).second == 801, "");
+#endif // #ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+    }
+
+    void test_constexpr_sorted_map()
+    {
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+        constexpr better_enums::sorted_map<Protocol, int>   codes =
+            better_enums::make_sorted_map(wire_code);
+
+        static_assert(codes[Protocol::Ftp] == 211, "");
+        static_assert(codes.to_enum(4431) == +Protocol::Https, "");
+        static_assert(!codes.to_enum_nothrow(4430), "");
+#endif // #ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+    }
+};
@@ -0,0 +1,95 @@
+#include <cxxtest/TestSuite.h>
+#include <enum.h>
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+#include <better-enums/matcher.h>
+
+
+
+BETTER_ENUM(Keyword, int, For, fork, Format, FORMAT, format, Do = 10, D)
+
+typedef better_enums::matcher<Keyword>          KeywordMatcher;
+typedef better_enums::nocase_matcher<Keyword>   NocaseKeywordMatcher;
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+class MatcherTests : public CxxTest::TestSuite {
+  public:
+    void test_characters()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        using better_enums::match_status;
+
+        KeywordMatcher  matcher;
+        TS_ASSERT_EQUALS(matcher.status(), match_status::undecided);
+        TS_ASSERT(!matcher.result());
+
+        TS_ASSERT_EQUALS(matcher.feed('F'), match_status::undecided);
+        TS_ASSERT_EQUALS(matcher.feed('o'), match_status::undecided);
+        TS_ASSERT_EQUALS(matcher.feed('r'), match_status::match);
+        TS_ASSERT_EQUALS(*matcher.result(), +Keyword::For);
+
+        TS_ASSERT_EQUALS(matcher.feed('m'), match_status::undecided);
+        TS_ASSERT(!matcher.result());
+        TS_ASSERT_EQUALS(matcher.feed('A'), match_status::no_match);
+        TS_ASSERT_EQUALS(matcher.feed('a'), match_status::no_match);
+        TS_ASSERT_EQUALS(matcher.length(), 5u);
+        TS_ASSERT(!matcher.result());
+
+        matcher.reset();
+        TS_ASSERT_EQUALS(matcher.feed('D'), match_status::match);
+        TS_ASSERT_EQUALS(*matcher.result(), +Keyword::D);
+        TS_ASSERT_EQUALS(matcher.feed('o'), match_status::match);
+        TS_ASSERT_EQUALS(*matcher.result(), +Keyword::Do);
+        TS_ASSERT_EQUALS(matcher.length(), 2u);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_chunks()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        using better_enums::match_status;
+
+        KeywordMatcher  matcher;
+        TS_ASSERT_EQUALS(matcher.feed("for", 3), match_status::undecided);
+        TS_ASSERT_EQUALS(matcher.feed("ma", 2), match_status::undecided);
+        TS_ASSERT_EQUALS(matcher.feed("t", 1), match_status::match);
+        TS_ASSERT_EQUALS(*matcher.result(), +Keyword::format);
+
+        matcher.reset();
+        TS_ASSERT_EQUALS(matcher.feed("FORM", 4), match_status::undecided);
+        TS_ASSERT_EQUALS(matcher.feed("AT", 2), match_status::match);
+        TS_ASSERT_EQUALS(*matcher.result(), +Keyword::FORMAT);
+
+        matcher.reset();
+        TS_ASSERT_EQUALS(matcher.feed("Fork", 4), match_status::no_match);
+        TS_ASSERT_EQUALS(matcher.length(), 4u);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_nocase()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        using better_enums::match_status;
+
+        NocaseKeywordMatcher    matcher;
+        TS_ASSERT_EQUALS(matcher.feed("fOR", 3), match_status::match);
+        TS_ASSERT_EQUALS(*matcher.result(), +Keyword::For);
+        TS_ASSERT_EQUALS(matcher.feed("K", 1), match_status::match);
+        TS_ASSERT_EQUALS(*matcher.result(), +Keyword::fork);
+
+        matcher.reset();
+        TS_ASSERT_EQUALS(matcher.feed("formaT", 6), match_status::match);
+        TS_ASSERT_EQUALS(*matcher.result(), +Keyword::Format);
+        TS_ASSERT_EQUALS(*matcher.result(),
+                         *Keyword::_from_string_nocase_nothrow("formaT"));
+
+        matcher.reset();
+        TS_ASSERT_EQUALS(matcher.feed("dx", 2), match_status::no_match);
+        TS_ASSERT_EQUALS(matcher.length(), 2u);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+};
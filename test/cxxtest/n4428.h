@@ -0,0 +1,67 @@
+#include <cxxtest/TestSuite.h>
+#include <enum.h>
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+#include <string>
+#include <better-enums/n4428.h>
+
+
+
+BETTER_ENUM(Suit, int, Clubs = 1, Diamonds, Hearts = 10, Spades)
+
+typedef std::enum_traits<Suit>::enumerators     Suits;
+
+static_assert(Suits::get_literal<0>::value == +Suit::Clubs, "");
+static_assert(Suits::get_literal<3>::value == +Suit::Spades, "");
+
+static_assert(Suits::get_literal<0>::identifier.size() == 5, "");
+static_assert(Suits::get_literal<2>::identifier.size() == 6, "");
+static_assert(Suits::get_literal<2>::identifier[0] == 'H', "");
+static_assert(Suits::get_literal<2>::identifier[5] == 's', "");
+
+static_assert(better_enums::identifier<Suit>(1).size() == 8, "");
+static_assert(better_enums::identifier<Suit>(3)[5] == 's', "");
+
+#ifdef BETTER_ENUMS_HAVE_STRING_VIEW
+static_assert(std::string_view(Suits::get_literal<1>::identifier) ==
+              "Diamonds", "");
+#endif
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+class N4428Tests : public CxxTest::TestSuite {
+  public:
+    void test_identifiers()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        constexpr better_enums::string_literal  hearts =
+            Suits::get_literal<2>::identifier;
+
+        TS_ASSERT_EQUALS(std::string(hearts.begin(), hearts.end()), "Hearts");
+
+        for (std::size_t index = 0; index < Suit::_size(); ++index) {
+            better_enums::string_literal    identifier =
+                better_enums::identifier<Suit>(index);
+
+            TS_ASSERT_EQUALS(std::string(identifier.data(), identifier.size()),
+                             Suit::_names()[index]);
+        }
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_identifier_by_reference()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        const better_enums::string_literal  &spades =
+            Suits::get_literal<3>::identifier;
+        const Suit                          &value =
+            Suits::get_literal<3>::value;
+
+        TS_ASSERT_EQUALS(spades.size(), 6u);
+        TS_ASSERT_EQUALS(value, +Suit::Spades);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+};
@@ -0,0 +1,148 @@
+#include <cxxtest/TestSuite.h>
+#include <enum.h>
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+#include <cstdint>
+#include <vector>
+#include <better-enums/packed.h>
+
+
+
+BETTER_ENUM(Tint, int, Black = 30, Red, Green, Yellow, Blue, Magenta, Cyan,
+                       White, Gray = 90, Silver)
+
+BETTER_ENUM(Coin, int, Heads = -1, Tails = 1)
+
+typedef better_enums::packed_vector<Tint>                   Tints;
+typedef better_enums::packed_vector<Tint, unsigned char>    ByteTints;
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+class PackedTests : public CxxTest::TestSuite {
+  public:
+    void test_layout()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        TS_ASSERT_EQUALS(Tints::bits_per_element(), 4u);
+        TS_ASSERT_EQUALS(Tints::elements_per_word(), 16u);
+        TS_ASSERT_EQUALS(ByteTints::elements_per_word(), 2u);
+        TS_ASSERT_EQUALS(better_enums::packed_vector<Coin>::bits_per_element(),
+                         1u);
+        TS_ASSERT_EQUALS(
+            better_enums::packed_view<Coin>::words_for(65), 2u);
+
+        Tints   tints(33);
+        TS_ASSERT_EQUALS(tints.size(), 33u);
+        TS_ASSERT_EQUALS(tints.word_count(), 3u);
+        TS_ASSERT_EQUALS(tints[32], +Tint::Black);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_references()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        Tints   tints(20, Tint::Cyan);
+
+        tints[0] = Tint::Silver;
+        tints[15] = Tint::Red;
+        tints[16] = tints[0];
+
+        TS_ASSERT_EQUALS(tints[0], +Tint::Silver);
+        TS_ASSERT_EQUALS(tints[1], +Tint::Cyan);
+        TS_ASSERT_EQUALS(tints[15], +Tint::Red);
+        TS_ASSERT_EQUALS(tints[16], +Tint::Silver);
+        TS_ASSERT_EQUALS(tints[19], +Tint::Cyan);
+        TS_ASSERT(tints[15] == Tint::Red);
+
+        const Tints &constant = tints;
+        TS_ASSERT_EQUALS(constant[16]._to_integral(), 91);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_growth()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        ByteTints   tints;
+        TS_ASSERT(tints.empty());
+
+        tints.push_back(Tint::Gray);
+        tints.push_back(Tint::White);
+        tints.push_back(Tint::Blue);
+
+        TS_ASSERT_EQUALS(tints.size(), 3u);
+        TS_ASSERT_EQUALS(tints.word_count(), 2u);
+        TS_ASSERT_EQUALS(tints[2], +Tint::Blue);
+
+        tints.pop_back();
+        TS_ASSERT_EQUALS(tints.word_count(), 1u);
+
+        ByteTints   same;
+        same.push_back(Tint::Gray);
+        same.push_back(Tint::White);
+        same.push_back(Tint::Green);
+        same.resize(2);
+        TS_ASSERT_EQUALS(tints, same);
+
+        same.resize(5, Tint::Yellow);
+        TS_ASSERT_EQUALS(same.size(), 5u);
+        TS_ASSERT_EQUALS(same[4], +Tint::Yellow);
+        TS_ASSERT_DIFFERS(tints, same);
+
+        same.clear();
+        TS_ASSERT(same.empty());
+        TS_ASSERT_EQUALS(same.word_count(), 0u);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_pack_unpack()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        std::vector<Tint>   values;
+        for (std::size_t index = 0; index < 100; ++index)
+            values.push_back(Tint::_values()[index * 7 % Tint::_size()]);
+
+        Tints   tints(values.data(), values.size());
+        TS_ASSERT_EQUALS(tints.word_count(), 7u);
+
+        for (std::size_t index = 0; index < values.size(); ++index)
+            TS_ASSERT_EQUALS(tints[index], values[index]);
+
+        std::vector<Tint>   unpacked(values.size(), Tint::Black);
+        tints.copy_to(unpacked.data());
+        TS_ASSERT(unpacked == values);
+
+        Tints   elementwise;
+        for (std::size_t index = 0; index < values.size(); ++index)
+            elementwise.push_back(values[index]);
+        TS_ASSERT_EQUALS(elementwise, tints);
+
+        std::uint32_t   words[5] =
+            {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu};
+        better_enums::pack(values.data(), 25, words);
+        TS_ASSERT_EQUALS(words[3] >> 4, 0u);
+        TS_ASSERT_EQUALS(words[4], 0xffffffffu);
+
+        better_enums::packed_view<Tint, std::uint32_t>  view(words, 25);
+        TS_ASSERT_EQUALS(view.word_count(), 4u);
+        TS_ASSERT_EQUALS(view[24], values[24]);
+
+        view[24] = Tint::Gray;
+        view.set(0, Tint::Silver);
+        TS_ASSERT_EQUALS(view.get(24), +Tint::Gray);
+        TS_ASSERT_EQUALS(view[0], +Tint::Silver);
+        TS_ASSERT_EQUALS(view[1], values[1]);
+
+        Tints   copy(tints.size());
+        copy.view().assign(values.data());
+        TS_ASSERT_EQUALS(copy, tints);
+
+        Coin                                coins[3] =
+            {Coin::Tails, Coin::Heads, Coin::Tails};
+        better_enums::packed_vector<Coin>   flips(coins, 3);
+        TS_ASSERT_EQUALS(flips.data()[0], 5u);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+};
@@ -0,0 +1,153 @@
+#include <cxxtest/TestSuite.h>
+#include <iterator>
+#include <enum.h>
+#include <better-enums/enum_set.h>
+
+
+
+BETTER_ENUM(Permission, int, Read = 4, Write = 2, Execute = 1, Owner = 400,
+                             Group = 40, Others = 4000, Sticky = 1000,
+                             SetUser = 4000000, SetGroup = 2000000, Admin = -1)
+
+typedef better_enums::enum_set<Permission>                  Permissions;
+typedef better_enums::enum_set<Permission, unsigned char>   BytePermissions;
+
+
+
+class SetTests : public CxxTest::TestSuite {
+  public:
+    void test_word_type()
+    {
+        TS_ASSERT_EQUALS(sizeof(Permissions::word_type),
+                         sizeof(unsigned short));
+        TS_ASSERT_EQUALS(sizeof(Permissions), sizeof(unsigned short));
+        TS_ASSERT_EQUALS(sizeof(BytePermissions), 2u);
+        TS_ASSERT_EQUALS(Permissions::max_size(), Permission::_size());
+    }
+
+    void test_insert_erase()
+    {
+        Permissions     permissions;
+
+        TS_ASSERT(permissions.empty());
+        TS_ASSERT_EQUALS(permissions.size(), 0u);
+
+        permissions.insert(Permission::Read).insert(Permission::Admin);
+
+        TS_ASSERT(!permissions.empty());
+        TS_ASSERT_EQUALS(permissions.size(), 2u);
+        TS_ASSERT(permissions.contains(Permission::Read));
+        TS_ASSERT(permissions.contains(Permission::Admin));
+        TS_ASSERT(!permissions.contains(Permission::Write));
+
+        permissions.erase(Permission::Read).erase(Permission::Write);
+
+        TS_ASSERT_EQUALS(permissions.size(), 1u);
+        TS_ASSERT(!permissions.contains(Permission::Read));
+
+        permissions.clear();
+        TS_ASSERT(permissions.empty());
+    }
+
+    void test_all()
+    {
+        TS_ASSERT_EQUALS(Permissions::all().size(), Permission::_size());
+        TS_ASSERT_EQUALS(BytePermissions::all().size(), Permission::_size());
+        TS_ASSERT_EQUALS(~Permissions::all(), Permissions());
+        TS_ASSERT_EQUALS(~BytePermissions(), BytePermissions::all());
+    }
+
+    void test_set_operations()
+    {
+        BytePermissions a;
+        BytePermissions b;
+
+        a.insert(Permission::Read).insert(Permission::Sticky)
+         .insert(Permission::SetUser);
+        b.insert(Permission::Sticky).insert(Permission::SetUser)
+         .insert(Permission::Admin);
+
+        TS_ASSERT_EQUALS((a | b).size(), 4u);
+        TS_ASSERT_EQUALS((a & b).size(), 2u);
+        TS_ASSERT_EQUALS((a ^ b).size(), 2u);
+        TS_ASSERT_EQUALS((a - b).size(), 1u);
+        TS_ASSERT((a - b).contains(Permission::Read));
+        TS_ASSERT((a ^ b).contains(Permission::Admin));
+        TS_ASSERT_EQUALS(a | b, (a ^ b) | (a & b));
+        TS_ASSERT_DIFFERS(a, b);
+
+        a &= b;
+        TS_ASSERT_EQUALS(a, b - BytePermissions().insert(Permission::Admin));
+    }
+
+    void test_iteration()
+    {
+        BytePermissions permissions;
+
+        TS_ASSERT(permissions.begin() == permissions.end());
+
+        permissions.insert(Permission::Admin).insert(Permission::Read)
+                   .insert(Permission::SetUser);
+
+        BytePermissions::const_iterator iterator = permissions.begin();
+
+        TS_ASSERT_EQUALS(*iterator, +Permission::Read);
+        ++iterator;
+        TS_ASSERT_EQUALS(*iterator, +Permission::SetUser);
+        TS_ASSERT_EQUALS(*iterator++, +Permission::SetUser);
+        TS_ASSERT_EQUALS(*iterator, +Permission::Admin);
+        ++iterator;
+        TS_ASSERT(iterator == permissions.end());
+
+        std::size_t count = 0;
+        for (BytePermissions::const_iterator member = permissions.begin();
+             member != permissions.end(); ++member) {
+
+            ++count;
+        }
+        TS_ASSERT_EQUALS(count, 3u);
+        TS_ASSERT_EQUALS(std::distance(permissions.begin(), permissions.end()),
+                         3);
+        TS_ASSERT_EQUALS(permissions.begin()->_to_integral(), 4);
+
+        std::size_t index = 0;
+        Permissions all = Permissions::all();
+        for (Permissions::const_iterator member = all.begin();
+             member != all.end(); ++member, ++index) {
+
+            TS_ASSERT_EQUALS(*member, Permission::_values()[index]);
+        }
+        TS_ASSERT_EQUALS(index, Permission::_size());
+    }
+
+    void test_wide_word()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        typedef better_enums::enum_set<Permission, unsigned long long>
+                                                            WidePermissions;
+
+        WidePermissions permissions =
+            WidePermissions().insert(Permission::Admin)
+                             .insert(Permission::Read);
+
+        TS_ASSERT_EQUALS(sizeof(permissions), sizeof(unsigned long long));
+        TS_ASSERT_EQUALS(permissions.size(), 2u);
+        TS_ASSERT_EQUALS(*permissions.begin(), +Permission::Read);
+        TS_ASSERT_EQUALS(WidePermissions::all().size(), Permission::_size());
+        TS_ASSERT_EQUALS((~permissions).size(), Permission::_size() - 2);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_constexpr_set()
+    {
+#ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+        constexpr Permissions   permissions =
+            Permissions().insert(Permission::Owner).insert(Permission::Group);
+
+        static_assert(permissions.size() == 2, "");
+        static_assert(permissions.contains(Permission::Group), "");
+        static_assert(*permissions.begin() == +Permission::Owner, "");
+        static_assert((~permissions).size() == Permission::_size() - 2, "");
+#endif // #ifdef BETTER_ENUMS_HAVE_RELAXED_CONSTEXPR
+    }
+};
@@ -1,10 +1,19 @@
 #include <cxxtest/TestSuite.h>
 #include <iostream>
+#include <sstream>
 #include <enum.h>
 
 
 
 BETTER_ENUM(Compiler, int, GCC, Clang, MSVC)
+BETTER_ENUM(Shell, int, Bash = 1, Zsh, Fish = 10)
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+static_assert(Compiler::_max_name_length_constant == 5, "");
+static_assert(better_enums::max_name_length<Shell>() == 4, "");
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
 
 
 
@@ -26,4 +35,60 @@ class StreamOperatorTests : public CxxTest::TestSuite {
         stream >> compiler;
         TS_ASSERT_EQUALS(compiler, +Compiler::Clang);
     }
+
+    void test_input_sequence()
+    {
+        std::istringstream  stream("  MSVC\tGCC\n Clang");
+        Compiler            first = Compiler::Clang;
+        Compiler            second = Compiler::Clang;
+        Compiler            third = Compiler::GCC;
+
+        stream >> first >> second >> third;
+        TS_ASSERT(!stream.fail());
+        TS_ASSERT(stream.eof());
+        TS_ASSERT_EQUALS(first, +Compiler::MSVC);
+        TS_ASSERT_EQUALS(second, +Compiler::GCC);
+        TS_ASSERT_EQUALS(third, +Compiler::Clang);
+    }
+
+    void test_wide_input()
+    {
+        std::wistringstream stream(L"Zsh Fish");
+        Shell               first = Shell::Bash;
+        Shell               second = Shell::Bash;
+
+        stream >> first >> second;
+        TS_ASSERT(!stream.fail());
+        TS_ASSERT_EQUALS(first, +Shell::Zsh);
+        TS_ASSERT_EQUALS(second, +Shell::Fish);
+    }
+
+    void test_invalid_input()
+    {
+        Shell               shell = Shell::Zsh;
+
+        std::istringstream  unknown("Dash");
+        unknown >> shell;
+        TS_ASSERT(unknown.fail());
+        TS_ASSERT_EQUALS(shell, +Shell::Zsh);
+
+        std::istringstream  too_long("Bashfulness Zsh");
+        too_long >> shell;
+        TS_ASSERT(too_long.fail());
+        TS_ASSERT_EQUALS(shell, +Shell::Zsh);
+
+        std::istringstream  empty("   ");
+        empty >> shell;
+        TS_ASSERT(empty.fail());
+        TS_ASSERT(empty.eof());
+    }
+
+    void test_max_name_length()
+    {
+        TS_ASSERT_EQUALS(Compiler::_max_name_length(), 5u);
+        TS_ASSERT_EQUALS(Shell::_max_name_length(), 9u);
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        TS_ASSERT_EQUALS(better_enums::max_name_length<Shell>(), 4u);
+#endif
+    }
 };
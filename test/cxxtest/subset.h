@@ -0,0 +1,75 @@
+#include <cxxtest/TestSuite.h>
+#include <enum.h>
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+#include <vector>
+#include <better-enums/subset.h>
+
+
+
+BETTER_ENUM(Failure, int, None = 0, Timeout = 110, Refused = 111, Busy = 16,
+                          Denied = 13, Again = 11, Retry = 110)
+
+typedef better_enums::subset<Failure, Failure::Timeout, Failure::Busy,
+                             Failure::Again, Failure::Retry>    Retryable;
+typedef better_enums::subset<Failure>                           Fatal;
+
+static_assert(Retryable::contains(Failure::Timeout), "");
+static_assert(Retryable::contains(Failure::Retry), "");
+static_assert(!Retryable::contains(Failure::Denied), "");
+static_assert(Retryable::size() == 3, "");
+static_assert(!Retryable::empty(), "");
+static_assert(Fatal::empty(), "");
+static_assert(Retryable::word_count() == 1, "");
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+class SubsetTests : public CxxTest::TestSuite {
+  public:
+    void test_contains()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        TS_ASSERT(Retryable::contains(Failure::Busy));
+        TS_ASSERT(Retryable::contains(Failure::Again));
+        TS_ASSERT(!Retryable::contains(Failure::None));
+        TS_ASSERT(!Retryable::contains(Failure::Refused));
+        TS_ASSERT(!Fatal::contains(Failure::Timeout));
+
+        TS_ASSERT_EQUALS(Retryable::words()[0], 0x2au);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_iteration()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        std::vector<Failure>    members;
+        for (Failure failure : Retryable())
+            members.push_back(failure);
+
+        TS_ASSERT_EQUALS(members.size(), 3u);
+        TS_ASSERT_EQUALS(members[0], +Failure::Timeout);
+        TS_ASSERT_EQUALS(members[1], +Failure::Busy);
+        TS_ASSERT_EQUALS(members[2], +Failure::Again);
+
+        TS_ASSERT(Fatal::begin() == Fatal::end());
+
+        std::vector<Failure>    copied(Retryable::begin(), Retryable::end());
+        TS_ASSERT(copied == members);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_set()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        better_enums::enum_set<Failure> set = Retryable::set();
+
+        TS_ASSERT_EQUALS(set.size(), 3u);
+        TS_ASSERT(set.contains(Failure::Busy));
+        TS_ASSERT(!set.contains(Failure::Denied));
+        TS_ASSERT_EQUALS(Fatal::set(), better_enums::enum_set<Failure>());
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+};
@@ -0,0 +1,132 @@
+#include <cxxtest/TestSuite.h>
+#include <enum.h>
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+BETTER_ENUM(Message, short, Hello = 1, Data, Ack = 10, Goodbye)
+BETTER_ENUM(MessageAlias, int, Ping = 5, Pong = 2, Echo = 5, Close)
+BETTER_ENUM(Scattered, int, Far = 1000, Near = -3, Middle = 40, Again = 1000)
+BETTER_ENUM(Evens, int,
+            E0, E2 = 2, E4 = 4, E6 = 6, E8 = 8, E10 = 10, E12 = 12, E14 = 14,
+            E16 = 16, E18 = 18, E20 = 20, E22 = 22, E24 = 24, E26 = 26,
+            E28 = 28, E30 = 30, E32 = 32, E34 = 34, E36 = 36, E38 = 38,
+            E40 = 40, E42 = 42, E44 = 44, E46 = 46, E48 = 48, E50 = 50,
+            E52 = 52, E54 = 54, E56 = 56, E58 = 58, E60 = 60, E62 = 62,
+            E64 = 64, E66 = 66, E68 = 68, E70 = 70, E72 = 72, E74 = 74,
+            E76 = 76, E78 = 78)
+
+template <typename Enum, typename Enum::_enumerated Constant>
+struct Handler {
+    static int run() { return Enum(Constant)._to_integral() * 100; }
+};
+
+template <typename Enum>
+struct Dispatch {
+    template <typename Constant>
+    int operator ()(Constant) const
+        { return Handler<Enum, Constant::value>::run(); }
+};
+
+struct CountCalls {
+    template <typename Constant>
+    void operator ()(Constant) { ++calls; }
+
+    int calls;
+};
+
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+
+
+
+class VisitTests : public CxxTest::TestSuite {
+  public:
+    void test_increasing_values()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        for (Message message : Message::_values()) {
+            TS_ASSERT_EQUALS(better_enums::visit(message, Dispatch<Message>()),
+                             message._to_integral() * 100);
+        }
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_aliased_values()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        Dispatch<MessageAlias>  dispatch;
+
+        TS_ASSERT_EQUALS(better_enums::visit(+MessageAlias::Ping, dispatch),
+                         500);
+        TS_ASSERT_EQUALS(better_enums::visit(+MessageAlias::Pong, dispatch),
+                         200);
+        TS_ASSERT_EQUALS(better_enums::visit(+MessageAlias::Echo, dispatch),
+                         500);
+        TS_ASSERT_EQUALS(better_enums::visit(+MessageAlias::Close, dispatch),
+                         600);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_sparse_aliased_values()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        Dispatch<Scattered> dispatch;
+
+        TS_ASSERT_EQUALS(better_enums::visit(+Scattered::Far, dispatch),
+                         100000);
+        TS_ASSERT_EQUALS(better_enums::visit(+Scattered::Near, dispatch),
+                         -300);
+        TS_ASSERT_EQUALS(better_enums::visit(+Scattered::Middle, dispatch),
+                         4000);
+        TS_ASSERT_EQUALS(better_enums::visit(+Scattered::Again, dispatch),
+                         100000);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_more_than_one_block()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        for (Evens value : Evens::_values()) {
+            TS_ASSERT_EQUALS(better_enums::visit(value, Dispatch<Evens>()),
+                             value._to_integral() * 100);
+        }
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_invalid_value()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        TS_ASSERT_EQUALS(
+            better_enums::visit(Message::_from_integral_unchecked(3),
+                                Dispatch<Message>()),
+            100);
+        TS_ASSERT_EQUALS(
+            better_enums::visit(MessageAlias::_from_integral_unchecked(3),
+                                Dispatch<MessageAlias>()),
+            500);
+        TS_ASSERT_EQUALS(
+            better_enums::visit(Scattered::_from_integral_unchecked(3),
+                                Dispatch<Scattered>()),
+            100000);
+        TS_ASSERT_EQUALS(
+            better_enums::visit(Evens::_from_integral_unchecked(77),
+                                Dispatch<Evens>()),
+            0);
+        TS_ASSERT_EQUALS(
+            better_enums::visit(Evens::_from_integral_unchecked(-1),
+                                Dispatch<Evens>()),
+            0);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+
+    void test_visitor_by_reference()
+    {
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+        CountCalls  counter = {0};
+
+        better_enums::visit(+Message::Ack, counter);
+        better_enums::visit(+MessageAlias::Close, counter);
+
+        TS_ASSERT_EQUALS(counter.calls, 2);
+#endif // #ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+    }
+};
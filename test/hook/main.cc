@@ -0,0 +1,127 @@
+// Checks what BETTER_ENUMS_CONVERSION_HOOK is told about each conversion. The
+// hook has to be defined before enum.h is included, so this is a program of its
+// own, rather than a part of the cxxtest suite. It exits with a non-zero status
+// if a check fails.
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+struct event {
+    const char      *enum_name;
+    int             operation;
+    bool            found;
+    std::size_t     depth;
+};
+
+static event    last_event;
+static int      events = 0;
+static int      initializations = 0;
+
+static void record(const char *enum_name, int operation, bool found,
+                   std::size_t depth)
+{
+    event   reported = { enum_name, operation, found, depth };
+    last_event = reported;
+    ++events;
+}
+
+#define BETTER_ENUMS_CONVERSION_HOOK(enum_name, operation, found, depth)       \
+    (operation == better_enums::conversion_initialize ?                        \
+        static_cast<void>(++initializations) :                                 \
+        record(enum_name, operation, found, depth))
+
+#include <enum.h>
+
+BETTER_ENUM(Signal, int, Hangup = 1, Interrupt, Quit, Kill = 9, Term = 15)
+
+#ifdef BETTER_ENUMS_HAVE_CONSTEXPR
+#ifdef BETTER_ENUMS_HAVE_IS_CONSTANT_EVALUATED
+
+// Conversions evaluated at compile time skip the hook.
+static_assert(Signal::_from_integral(9) == +Signal::Kill, "");
+static_assert(Signal::_is_valid(15), "");
+
+#endif
+#endif
+
+static int failures = 0;
+
+static void check(bool condition, const char *description)
+{
+    if (!condition) {
+        std::printf("failed: %s\n", description);
+        ++failures;
+    }
+}
+
+// Checks that exactly one conversion was reported since the last call, and that
+// it was the given one. The depth is at least one for any lookup that was done,
+// and at most the number of constants.
+static void check_event(int operation, bool found, const char *description)
+{
+    check(events == 1, description);
+    check(std::strcmp(last_event.enum_name, "Signal") == 0, description);
+    check(last_event.operation == operation, description);
+    check(last_event.found == found, description);
+    check(last_event.depth >= 1 && last_event.depth <= Signal::_size(),
+          description);
+
+    events = 0;
+}
+
+int main()
+{
+    Signal  signal = Signal::_from_integral(3);
+    check(signal == +Signal::Quit, "_from_integral result");
+    check_event(better_enums::conversion_from_value, true, "_from_integral");
+
+    check(!Signal::_from_integral_nothrow(4), "_from_integral_nothrow result");
+    check_event(better_enums::conversion_from_value, false,
+                "_from_integral_nothrow");
+
+    check(std::strcmp(signal._to_string(), "Quit") == 0, "_to_string result");
+    check_event(better_enums::conversion_from_value, true, "_to_string");
+
+    check(Signal::_from_string("Term") == +Signal::Term, "_from_string result");
+    check_event(better_enums::conversion_from_name, true, "_from_string");
+
+    check(Signal::_from_string_nocase("kill") == +Signal::Kill,
+          "_from_string_nocase result");
+    check_event(better_enums::conversion_from_name_nocase, true,
+                "_from_string_nocase");
+
+    check(!Signal::_is_valid("Stop"), "_is_valid result");
+    check(events == 1 && !last_event.found, "_is_valid");
+    events = 0;
+
+    bool    thrown = false;
+    try {
+        Signal::_from_string("Hangupp");
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check(thrown, "_from_string exception");
+    check(events == 1 && !last_event.found &&
+          last_event.operation == better_enums::conversion_from_name,
+          "_from_string failure");
+    events = 0;
+
+    // Comparisons and switches don't look anything up.
+    check(signal == +Signal::Quit && signal != +Signal::Term, "comparison");
+    check(events == 0, "comparison does not report");
+
+    // Outside the full-constexpr mode, the names are trimmed exactly once,
+    // either before main or by the first conversion that needs them.
+#ifdef BETTER_ENUMS_CONSTEXPR_TO_STRING
+    check(initializations == 0, "initialization");
+#else
+    check(initializations == 1, "initialization");
+#endif
+
+    if (failures == 0)
+        std::printf("conversion hook: OK\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -6,3 +6,8 @@ void print(Channel channel)
     std::cout << Channel::_name() << "::" << channel._to_string() << std::endl;
     std::cout << Channel::_size() << std::endl;
 }
+
+const Channel* values_in_helper()
+{
+    return Channel::_values().begin();
+}
@@ -4,5 +4,6 @@
 #include "shared.h"
 
 void print(Channel channel);
+const Channel* values_in_helper();
 
 #endif // #ifndef HELPER_H
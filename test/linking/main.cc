@@ -5,5 +5,11 @@ int main()
 {
     print(Channel::Red);
 
+    // With inline data, both translation units refer to the same array.
+#ifdef BETTER_ENUMS_HAVE_INLINE_DATA
+    if (Channel::_values().begin() != values_in_helper())
+        return 1;
+#endif
+
     return 0;
 }
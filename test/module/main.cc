@@ -0,0 +1,74 @@
+// Uses Better Enums through the better_enums module, rather than through the
+// whole of enum.h. Built and run by "make module". Exits with a non-zero status
+// if a check fails.
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#define BETTER_ENUMS_MODULE_IMPORTED
+#include <enum.h>
+
+import better_enums;
+
+BETTER_ENUM(Channel, int, Red = 1, Green, Blue)
+BETTER_ENUM(Compass, char, North, East = 'E', South, West)
+
+static_assert(Channel::_from_string("Blue") == +Channel::Blue);
+static_assert(Channel::_size() == 3);
+
+static int failures = 0;
+
+static void check(bool condition, const char *description)
+{
+    if (!condition) {
+        std::printf("failed: %s\n", description);
+        ++failures;
+    }
+}
+
+int main()
+{
+    Channel     channel = Channel::_from_integral(2);
+    check(channel == +Channel::Green, "_from_integral");
+    check(std::strcmp(channel._to_string(), "Green") == 0, "_to_string");
+    check(Channel::_from_string_nocase("bLuE") == +Channel::Blue,
+          "_from_string_nocase");
+    check(!Channel::_from_string_nothrow("Cyan"), "_from_string_nothrow");
+
+    bool        thrown = false;
+    try {
+        Channel::_from_integral(7);
+    }
+    catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check(thrown, "_from_integral throws");
+
+    std::size_t names = 0;
+    for (const char *name : Compass::_names()) {
+        check(Compass::_is_valid(name), "_names");
+        ++names;
+    }
+    check(names == Compass::_size(), "_names size");
+
+    better_enums::optional<Compass>     maybe =
+        Compass::_from_string_nothrow("West");
+    check(maybe && *maybe == +Compass::West, "optional");
+
+    better_enums::enum_set<Compass>     set;
+    set.insert(Compass::East);
+    check(set.contains(Compass::East) && set.size() == 1, "enum_set");
+
+    std::stringstream   stream;
+    stream << +Compass::South;
+    Compass     read = Compass::North;
+    stream >> read;
+    check(read == +Compass::South, "stream operators");
+
+    if (failures == 0)
+        std::printf("module: OK\n");
+
+    return failures == 0 ? 0 : 1;
+}
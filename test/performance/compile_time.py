@@ -0,0 +1,327 @@
+#! /usr/bin/env python
+
+# This file is part of Better Enums, released under the BSD 2-clause license.
+# See LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+# Compile-time benchmark. Generates translation units that declare ENUMS Better
+# Enums of CONSTANTS constants each, with names of NAME_LENGTH characters, and
+# times how long the compiler takes to check each of them, in each declaration
+# mode and with each language standard:
+#
+#   default         BETTER_ENUM
+#   slow            SLOW_ENUM
+#   constexpr       BETTER_ENUM, with BETTER_ENUMS_CONSTEXPR_TO_STRING defined
+#   macro-file      BETTER_ENUM, with an external BETTER_ENUMS_MACRO_FILE
+#                   generated by script/make_macros.py
+#   generated       BETTER_ENUM, converted by script/make_enums.py
+#
+# slow and constexpr are skipped for C++98. Only macro-file and generated
+# support more than 64 constants. Every fourth constant has an initializer, so
+# that name trimming is exercised.
+#
+# Each measurement is the least CPU time, over REPEATS runs, of the compiler
+# with -fsyntax-only, minus the least time to check a file that only includes
+# enum.h. The two files are checked in turn, so that both times are taken under
+# the same load. Other load on the machine can only make a run slower, so the
+# least time varies much less from one benchmark run to the next than the
+# median. A file that only includes some standard headers is checked in turn
+# with them as well, as a reference for the speed of the machine at the time.
+# The results are written as JSON.
+#
+# If a baseline file from an earlier run is given, each of its measurements is
+# first scaled by how much the reference time has changed, so that a machine
+# that is uniformly slower, whether it is a different machine or the same one
+# under sustained load, doesn't look like a regression. Measurements that are
+# slower than that both by more than the tolerance and by more than the minimum
+# difference are taken again, up to RETRIES more times, so that a passing burst
+# of load is not mistaken for a regression either. Those that stay slower are
+# reported, and the script exits with status 1. The minimum difference keeps
+# fluctuations of a few milliseconds, in the smallest measurements, from being
+# reported.
+#
+# The script is usually run through the compile-time-benchmark target of
+# test/CMakeLists.txt. It only supports gcc and clang.
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+try:
+    import resource
+except ImportError:
+    resource = None
+
+try:
+    from StringIO import StringIO
+except ImportError:
+    from io import StringIO
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+sys.path.insert(0, os.path.join(ROOT, 'script'))
+sys.dont_write_bytecode = True
+
+import make_enums
+
+REFERENCE_SOURCE = '''#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+'''
+
+MODES = ['default', 'slow', 'constexpr', 'macro-file', 'generated']
+DEFAULT_LIMIT = 64
+INITIALIZER_EVERY = 4
+
+def parse_list(text, convert = str):
+    return [convert(item) for item in text.split(',') if item != '']
+
+def constant_name(enum, index, length):
+    prefix = 'E%iC%i' % (enum, index)
+    return prefix + 'x' * (length - len(prefix))
+
+def generate_source(mode, enums, constants, name_length):
+    macro = 'SLOW_ENUM' if mode == 'slow' else 'BETTER_ENUM'
+
+    lines = ['#include <enum.h>', '']
+    for enum in range(enums):
+        names = []
+        for index in range(constants):
+            name = constant_name(enum, index, name_length)
+            if index % INITIALIZER_EVERY == 0:
+                name += ' = %i' % (1000 + index)
+            names.append(name)
+
+        lines.append('%s(Enum%i, int,' % (macro, enum))
+        for index, name in enumerate(names):
+            ending = ')' if index == len(names) - 1 else ','
+            lines.append('    ' + name + ending)
+        lines.append('')
+
+    text = '\n'.join(lines)
+    if mode != 'generated':
+        return text
+
+    stream = StringIO()
+    make_enums.generate(stream, text, 'enums.cc', 'compile_time.py')
+    return stream.getvalue()
+
+def children_cpu_time():
+    usage = resource.getrusage(resource.RUSAGE_CHILDREN)
+    return usage.ru_utime + usage.ru_stime
+
+# Falls back to wall-clock time where resource usage is not available.
+def cpu_time(command):
+    if resource is None:
+        start = time.time()
+        subprocess.check_call(command)
+        return time.time() - start
+
+    before = children_cpu_time()
+    subprocess.check_call(command)
+    return children_cpu_time() - before
+
+# Returns the time taken by the enums, and the reference time.
+def measure(compiler, flags, path, empty, reference, repeats):
+    command = [compiler] + flags + ['-fsyntax-only']
+    empty_times = []
+    times = []
+    reference_times = []
+    for _ in range(repeats):
+        empty_times.append(cpu_time(command + [empty]))
+        times.append(cpu_time(command + [path]))
+        reference_times.append(cpu_time(command + [reference]))
+    return (max(0.0, min(times) - min(empty_times)), min(reference_times))
+
+def mode_flags(mode, std, macro_file):
+    flags = ['-std=' + std, '-I' + ROOT, '-I' + os.path.join(ROOT, 'extra')]
+    if mode == 'constexpr':
+        flags.append('-DBETTER_ENUMS_CONSTEXPR_TO_STRING')
+    if mode == 'macro-file':
+        flags.append('-DBETTER_ENUMS_MACRO_FILE=<' + macro_file + '>')
+    return flags
+
+def supported(mode, std, constants):
+    if mode in ('slow', 'constexpr') and std in ('c++98', 'c++03'):
+        return False
+    if mode not in ('macro-file', 'generated') and constants > DEFAULT_LIMIT:
+        return False
+    return True
+
+def write_macro_file(directory, constants):
+    path = os.path.join(directory, 'macros.h')
+    script = os.path.join(ROOT, 'script', 'make_macros.py')
+
+    with open(path, 'w') as stream:
+        subprocess.check_call(
+            [sys.executable, script, str(constants)],
+            stdout = stream)
+
+    return path
+
+def key(result):
+    return (result['mode'], result['std'], result['enums'],
+            result['constants'], result['name_length'])
+
+# The time old would take at the speed of the machine when result was taken.
+# Baselines without reference times are not scaled.
+def scaled(old, result):
+    if old.get('reference_seconds', 0) <= 0:
+        return old['seconds']
+    return (old['seconds'] * result['reference_seconds'] /
+            old['reference_seconds'])
+
+def slower(result, old, tolerance, minimum_difference):
+    expected = scaled(old, result)
+    return (result['seconds'] > expected * (1 + tolerance) and
+            result['seconds'] - expected > minimum_difference)
+
+# Measures the results that are slower than in the baseline again, keeping the
+# measurement that is the least slower, and returns whether none of them is
+# still slower.
+def compare(results, baseline_path, tolerance, minimum_difference, retries,
+            remeasure):
+    with open(baseline_path) as stream:
+        baseline = dict((key(result), result)
+                        for result in json.load(stream)['results'])
+
+    regressions = []
+    for result in results:
+        old = baseline.get(key(result))
+        if old is None:
+            continue
+
+        for _ in range(retries):
+            if not slower(result, old, tolerance, minimum_difference):
+                break
+            again = remeasure(result)
+            if again['seconds'] - scaled(old, again) < \
+               result['seconds'] - scaled(old, result):
+                result.update(again)
+
+        if slower(result, old, tolerance, minimum_difference):
+            regressions.append((result, old))
+
+    for result, old in regressions:
+        print('regression: %s %s enums=%i constants=%i name_length=%i: '
+              '%.3fs, was %.3fs, or %.3fs at the current speed' %
+              (result['mode'], result['std'], result['enums'],
+               result['constants'], result['name_length'], result['seconds'],
+               old['seconds'], scaled(old, result)), file=sys.stderr)
+
+    return len(regressions) == 0
+
+def main():
+    parser = argparse.ArgumentParser(
+        description = 'Measure the compile time of Better Enums.')
+    parser.add_argument('--compiler', default = 'c++')
+    parser.add_argument('--std', default = 'c++98,c++11,c++14,c++17',
+                        help = 'comma-separated list of -std= values')
+    parser.add_argument('--modes', default = ','.join(MODES),
+                        help = 'comma-separated subset of ' + ','.join(MODES))
+    parser.add_argument('--enums', default = '1,16')
+    parser.add_argument('--constants', default = '8,64,256')
+    parser.add_argument('--name-lengths', default = '8,20')
+    parser.add_argument('--repeats', type = int, default = 5)
+    parser.add_argument('--output', default = 'compile-time.json')
+    parser.add_argument('--baseline',
+                        help = 'JSON output of an earlier run to compare with')
+    parser.add_argument('--tolerance', type = float, default = 0.2,
+                        help = 'allowed relative slowdown (default 0.2)')
+    parser.add_argument('--minimum-difference', type = float, default = 0.025,
+                        help = 'slowdowns of at most this many seconds are '
+                               'allowed (default 0.025)')
+    parser.add_argument('--retries', type = int, default = 3,
+                        help = 'times to measure apparent regressions again '
+                               '(default 3)')
+    arguments = parser.parse_args()
+
+    standards = parse_list(arguments.std)
+    modes = parse_list(arguments.modes)
+    enum_counts = parse_list(arguments.enums, int)
+    constant_counts = parse_list(arguments.constants, int)
+    name_lengths = parse_list(arguments.name_lengths, int)
+
+    for mode in modes:
+        if mode not in MODES:
+            parser.error('unknown mode: ' + mode)
+
+    directory = tempfile.mkdtemp(prefix = 'better-enums-')
+    try:
+        macro_file = write_macro_file(directory, max(constant_counts))
+
+        empty = os.path.join(directory, 'empty.cc')
+        with open(empty, 'w') as stream:
+            stream.write('#include <enum.h>\n')
+
+        reference = os.path.join(directory, 'reference.cc')
+        with open(reference, 'w') as stream:
+            stream.write(REFERENCE_SOURCE)
+
+        source = os.path.join(directory, 'enums.cc')
+
+        def run(mode, std, enums, constants, name_length):
+            with open(source, 'w') as stream:
+                stream.write(generate_source(
+                    mode, enums, constants, name_length))
+
+            seconds, reference_seconds = measure(
+                arguments.compiler, mode_flags(mode, std, macro_file), source,
+                empty, reference, arguments.repeats)
+
+            return {
+                'mode': mode,
+                'std': std,
+                'enums': enums,
+                'constants': constants,
+                'name_length': name_length,
+                'seconds': round(seconds, 4),
+                'seconds_per_enum': round(seconds / enums, 5),
+                'reference_seconds': round(reference_seconds, 4)
+            }
+
+        results = []
+        for std in standards:
+            for mode in modes:
+                for enums in enum_counts:
+                    for constants in constant_counts:
+                        if not supported(mode, std, constants):
+                            continue
+
+                        for name_length in name_lengths:
+                            result = run(mode, std, enums, constants,
+                                         name_length)
+                            results.append(result)
+
+                            print('%-10s %-6s enums=%-4i constants=%-4i '
+                                  'name_length=%-3i %.3fs' %
+                                  (mode, std, enums, constants, name_length,
+                                   result['seconds']))
+                            sys.stdout.flush()
+
+        passed = True
+        if arguments.baseline is not None:
+            passed = compare(
+                results, arguments.baseline, arguments.tolerance,
+                arguments.minimum_difference, arguments.retries,
+                lambda result: run(result['mode'], result['std'],
+                                   result['enums'], result['constants'],
+                                   result['name_length']))
+    finally:
+        shutil.rmtree(directory)
+
+    with open(arguments.output, 'w') as stream:
+        json.dump({'compiler': arguments.compiler, 'results': results},
+                  stream, indent = 2, sort_keys = True)
+        stream.write('\n')
+
+    sys.exit(0 if passed else 1)
+
+if __name__ == '__main__':
+    main()
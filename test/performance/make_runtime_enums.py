@@ -0,0 +1,90 @@
+#! /usr/bin/env python
+
+# This file is part of Better Enums, released under the BSD 2-clause license.
+# See LICENSE for details, or visit http://github.com/aantron/better-enums.
+
+# Generates the enums measured by runtime.cc. Usage:
+#
+#   python make_runtime_enums.py DIRECTORY
+#
+# writes DIRECTORY/runtime-enums.h and DIRECTORY/runtime-macros.h. The first
+# declares one Better Enum for each combination of size in SIZES and value
+# distribution, and defines BENCHMARK_ENUMS, which applies a macro to each one.
+# The second is an external macro file, generated by script/make_macros.py, that
+# raises the limit on the number of constants to the largest size.
+#
+# Dense enums have the values 0, 1, 2, ... Sparse enums have values that are 37
+# apart, which is too far apart for the dense lookup table.
+
+from __future__ import print_function
+
+import os
+import sys
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+sys.path.insert(0, os.path.join(ROOT, 'script'))
+sys.dont_write_bytecode = True
+
+import make_macros
+
+SIZES = [4, 16, 64, 512]
+SPARSE_STRIDE = 37
+
+WORDS = ['Read', 'Write', 'Poll', 'Open', 'Close', 'Flush', 'Seek', 'Stat',
+         'Image', 'Post', 'User', 'Group', 'Key', 'Project', 'Comment',
+         'Permission']
+
+def constant_name(index):
+    name = WORDS[index % len(WORDS)] + \
+        WORDS[(index // len(WORDS)) % len(WORDS)]
+    if index >= len(WORDS) * len(WORDS):
+        name += str(index // (len(WORDS) * len(WORDS)))
+    return name
+
+def declare(stream, name, size, stride):
+    constants = []
+    for index in range(size):
+        constant = constant_name(index)
+        if stride != 1:
+            constant += ' = %i' % (index * stride)
+        constants.append(constant)
+
+    print('BETTER_ENUM(%s, int,' % name, file=stream)
+    for index, constant in enumerate(constants):
+        ending = ')' if index == len(constants) - 1 else ','
+        print('            ' + constant + ending, file=stream)
+    print('', file=stream)
+
+def generate(stream):
+    print('// This file was automatically generated by ' +
+          os.path.basename(__file__), file=stream)
+    print('', file=stream)
+    print('#pragma once', file=stream)
+    print('', file=stream)
+
+    names = []
+    for size in SIZES:
+        for distribution, stride in [('Dense', 1), ('Sparse', SPARSE_STRIDE)]:
+            name = '%s%i' % (distribution, size)
+            declare(stream, name, size, stride)
+            names.append((name, distribution.lower()))
+
+    print('#define BENCHMARK_ENUMS(X) \\', file=stream)
+    for name, distribution in names:
+        print('    X(%s, "%s") \\' % (name, distribution), file=stream)
+    print('', file=stream)
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        print('Usage: ' + sys.argv[0] + ' DIRECTORY', file=sys.stderr)
+        sys.exit(1)
+
+    directory = sys.argv[1]
+
+    with open(os.path.join(directory, 'runtime-enums.h'), 'w') as stream:
+        generate(stream)
+
+    with open(os.path.join(directory, 'runtime-macros.h'), 'w') as stream:
+        make_macros.generate(stream, max(SIZES), 'make_macros.py')
+
+    sys.exit(0)
@@ -0,0 +1,386 @@
+// Run-time benchmark of the conversion functions. The enums are generated by
+// make_runtime_enums.py, and the benchmark is built by the runtime-benchmark
+// target of test/CMakeLists.txt.
+//
+// For each enum, each operation is timed on every constant in turn, for at
+// least the number of seconds given as the only optional argument (default
+// 0.05). Miss inputs are integers that are not values of any constant, and
+// names that have the right length but differ in the last character. One line
+// is printed per measurement, with the average time per operation in
+// nanoseconds.
+//
+// The clock is read only after at least minimum_repetitions operations, so
+// that reading it does not dominate short operations. The time taken by the
+// timing loop itself, with an operation that does nothing, is printed first,
+// and subtracted from every measurement.
+
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <enum.h>
+#include <better-enums/batch.h>
+#include <better-enums/counters.h>
+#include <better-enums/encoding.h>
+#include <better-enums/matcher.h>
+#include <better-enums/packed.h>
+#include <better-enums/sorted_map.h>
+#include <better-enums/static_map.h>
+#include <better-enums/subset.h>
+#include "runtime-enums.h"
+
+
+
+static double               minimum_seconds = 0.05;
+static const std::size_t    minimum_repetitions = 1024;
+static double               loop_nanoseconds = 0;
+static volatile std::size_t sink;
+
+template <typename Operation>
+static double time_loop(std::size_t count, Operation operation)
+{
+    typedef std::chrono::steady_clock   clock;
+
+    const clock::duration   minimum =
+        std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(minimum_seconds));
+    const std::size_t       rounds =
+        (minimum_repetitions + count - 1) / count;
+
+    std::size_t         operations = 0;
+    clock::time_point   start = clock::now();
+    clock::time_point   now;
+
+    do {
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (std::size_t index = 0; index < count; ++index)
+                sink = sink + operation(index);
+        }
+
+        operations += rounds * count;
+        now = clock::now();
+    } while (now - start < minimum);
+
+    return
+        std::chrono::duration<double, std::nano>(now - start).count() /
+        static_cast<double>(operations);
+}
+
+template <typename Operation>
+static double nanoseconds_per_operation(std::size_t count, Operation operation)
+{
+    double  nanoseconds = time_loop(count, operation) - loop_nanoseconds;
+
+    return nanoseconds > 0 ? nanoseconds : 0;
+}
+
+static void report(const char *enum_name, std::size_t size,
+                   const char *distribution, const char *operation,
+                   const char *input, double nanoseconds)
+{
+    std::printf("%-10s %4u %-7s %-28s %-5s %9.2f\n",
+                enum_name, static_cast<unsigned>(size), distribution, operation,
+                input, nanoseconds);
+}
+
+template <typename Enum>
+constexpr int scrambled(Enum value)
+{
+    return value._to_integral() * 3 + 1;
+}
+
+struct visited_integral {
+    template <typename Constant>
+    std::size_t operator ()(Constant) const
+        { return static_cast<std::size_t>(Constant::value); }
+};
+
+template <typename Enum>
+static void benchmark(const char *distribution)
+{
+    const std::size_t   size = Enum::_size();
+    const char          *name = Enum::_name();
+
+    std::vector<Enum>           values;
+    std::vector<int>            integers;
+    std::vector<int>            missing_integers;
+    std::vector<int>            scrambled_integers;
+    std::vector<std::string>    names;
+    std::vector<std::string>    uppercase_names;
+    std::vector<std::string>    missing_names;
+
+    for (std::size_t index = 0; index < size; ++index) {
+        Enum        value = Enum::_values()[index];
+        std::string constant = value._to_string();
+
+        values.push_back(value);
+        integers.push_back(value._to_integral());
+        scrambled_integers.push_back(scrambled(value));
+
+        int missing = value._to_integral() + 1;
+        while (Enum::_is_valid(missing))
+            missing += static_cast<int>(size);
+        missing_integers.push_back(missing);
+
+        names.push_back(constant);
+
+        std::string uppercase = constant;
+        for (std::size_t c = 0; c < uppercase.size(); ++c) {
+            uppercase[c] = static_cast<char>(
+                std::toupper(static_cast<unsigned char>(uppercase[c])));
+        }
+        uppercase_names.push_back(uppercase);
+
+        std::string missing_name = constant;
+        missing_name[missing_name.size() - 1] = '_';
+        missing_names.push_back(missing_name);
+    }
+
+    report(name, size, distribution, "_to_string", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return reinterpret_cast<std::size_t>(values[i]._to_string());
+        }));
+
+    report(name, size, distribution, "_to_index", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return values[i]._to_index();
+        }));
+
+    report(name, size, distribution, "visit", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return better_enums::visit(values[i], visited_integral());
+        }));
+
+    report(name, size, distribution, "_from_integral_nothrow", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                Enum::_from_integral_nothrow(integers[i]) ? 1 : 0);
+        }));
+
+    report(name, size, distribution, "_from_integral_nothrow", "miss",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                Enum::_from_integral_nothrow(missing_integers[i]) ? 1 : 0);
+        }));
+
+    std::vector<Enum>           batch_results(values);
+    std::unique_ptr<bool[]>     batch_ok(new bool[size]);
+
+    report(name, size, distribution, "from_integral_batch", "hit",
+        nanoseconds_per_operation(1, [&](std::size_t) {
+            return better_enums::from_integral_batch(
+                integers.data(), size, batch_results.data(), batch_ok.get());
+        }) / static_cast<double>(size));
+
+    report(name, size, distribution, "_from_string_nothrow", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                Enum::_from_string_nothrow(names[i].c_str()) ? 1 : 0);
+        }));
+
+    report(name, size, distribution, "_from_string_nothrow", "miss",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                Enum::_from_string_nothrow(missing_names[i].c_str()) ? 1 : 0);
+        }));
+
+    report(name, size, distribution, "_from_string_nocase_nothrow", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                Enum::_from_string_nocase_nothrow(
+                    uppercase_names[i].c_str()) ? 1 : 0);
+        }));
+
+    report(name, size, distribution, "_from_string_nocase_nothrow", "miss",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                Enum::_from_string_nocase_nothrow(
+                    missing_names[i].c_str()) ? 1 : 0);
+        }));
+
+    better_enums::matcher<Enum>         matcher;
+
+    report(name, size, distribution, "matcher::feed", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            matcher.reset();
+            matcher.feed(names[i].data(), names[i].size());
+            return static_cast<std::size_t>(matcher.result() ? 1 : 0);
+        }));
+
+    report(name, size, distribution, "matcher::feed", "miss",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            matcher.reset();
+            matcher.feed(missing_names[i].data(), missing_names[i].size());
+            return static_cast<std::size_t>(matcher.result() ? 1 : 0);
+        }));
+
+    const better_enums::map<Enum, int>  map =
+        better_enums::make_map(scrambled<Enum>);
+
+    report(name, size, distribution, "map::to_enum_nothrow", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                map.to_enum_nothrow(scrambled_integers[i]) ? 1 : 0);
+        }));
+
+    report(name, size, distribution, "map::to_enum_nothrow", "miss",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                map.to_enum_nothrow(scrambled_integers[i] + 1) ? 1 : 0);
+        }));
+
+    const better_enums::sorted_map<Enum, int>   sorted_map =
+        better_enums::make_sorted_map(scrambled<Enum>);
+
+    report(name, size, distribution, "sorted_map::to_enum_nothrow", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                sorted_map.to_enum_nothrow(scrambled_integers[i]) ? 1 : 0);
+        }));
+
+    report(name, size, distribution, "sorted_map::to_enum_nothrow", "miss",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                sorted_map.to_enum_nothrow(scrambled_integers[i] + 1) ? 1 : 0);
+        }));
+
+    typedef better_enums::static_map<Enum, int, scrambled<Enum> >  static_map;
+
+    report(name, size, distribution, "static_map::from_enum", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(static_map::from_enum(values[i]));
+        }));
+
+    report(name, size, distribution, "static_map::to_enum_nothrow", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                static_map::to_enum_nothrow(scrambled_integers[i]) ? 1 : 0);
+        }));
+
+    static better_enums::enum_counters<Enum>    counters;
+
+    report(name, size, distribution, "enum_counters::increment", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            counters.increment(values[i]);
+            return i;
+        }));
+
+    typedef better_enums::subset<Enum, Enum::_values()[0],
+                                 Enum::_values()[Enum::_size_constant / 2],
+                                 Enum::_values()[Enum::_size_constant - 1]>
+        subset;
+
+    report(name, size, distribution, "subset::contains", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(subset::contains(values[i]));
+        }));
+
+    better_enums::packed_vector<Enum>   packed(values.data(), size);
+    std::vector<Enum>                   unpacked(values);
+
+    report(name, size, distribution, "packed_vector::operator []", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                static_cast<Enum>(packed[i])._to_integral());
+        }));
+
+    report(name, size, distribution, "pack", "hit",
+        nanoseconds_per_operation(1, [&](std::size_t) {
+            better_enums::pack(values.data(), size, packed.data());
+            return static_cast<std::size_t>(packed.data()[0]);
+        }) / static_cast<double>(size));
+
+    report(name, size, distribution, "unpack", "hit",
+        nanoseconds_per_operation(1, [&](std::size_t) {
+            packed.copy_to(unpacked.data());
+            return static_cast<std::size_t>(unpacked[0]._to_integral());
+        }) / static_cast<double>(size));
+
+    std::ostringstream  output;
+
+    report(name, size, distribution, "operator <<", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            output.str(std::string());
+            output << values[i];
+            return static_cast<std::size_t>(output.tellp());
+        }));
+
+    std::vector<unsigned char>  fixed(size * better_enums::fixed_width<Enum>());
+    std::vector<unsigned char>  varints(size *
+                                        better_enums::varint_width<Enum>());
+    std::vector<std::size_t>    varint_offsets;
+    Enum                        decoded = values[0];
+
+    for (std::size_t index = 0, offset = 0; index < size; ++index) {
+        better_enums::encode_fixed(
+            values[index], &fixed[index * better_enums::fixed_width<Enum>()],
+            &fixed[0] + fixed.size());
+
+        varint_offsets.push_back(offset);
+        offset = static_cast<std::size_t>(
+            better_enums::encode_varint(values[index], &varints[offset],
+                                        &varints[0] + varints.size()) -
+            &varints[0]);
+    }
+
+    report(name, size, distribution, "decode_fixed", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            const unsigned char *first =
+                &fixed[i * better_enums::fixed_width<Enum>()];
+            better_enums::decode_fixed(first, &fixed[0] + fixed.size(),
+                                       decoded);
+            return static_cast<std::size_t>(decoded._to_integral());
+        }));
+
+    report(name, size, distribution, "decode_varint", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            better_enums::decode_varint(&varints[varint_offsets[i]],
+                                        &varints[0] + varints.size(), decoded);
+            return static_cast<std::size_t>(decoded._to_integral());
+        }));
+
+    char                written[Enum::_max_name_length_constant];
+
+    report(name, size, distribution, "_write_to", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            return static_cast<std::size_t>(
+                values[i]._write_to(written, written + sizeof(written)) -
+                    written);
+        }));
+
+    std::istringstream  input;
+    Enum                parsed = values[0];
+
+    report(name, size, distribution, "operator >>", "hit",
+        nanoseconds_per_operation(size, [&](std::size_t i) {
+            input.clear();
+            input.str(names[i]);
+            input >> parsed;
+            return static_cast<std::size_t>(parsed._to_integral());
+        }));
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+        minimum_seconds = std::atof(argv[1]);
+
+    loop_nanoseconds =
+        time_loop(minimum_repetitions, [](std::size_t i) { return i; });
+    std::printf("timing loop: %.2f ns/op, subtracted below\n\n",
+                loop_nanoseconds);
+
+    std::printf("%-10s %4s %-7s %-28s %-5s %9s\n",
+                "enum", "size", "values", "operation", "input", "ns/op");
+
+#define BENCHMARK(Enum, distribution) benchmark<Enum>(distribution);
+    BENCHMARK_ENUMS(BENCHMARK)
+#undef BENCHMARK
+
+    return 0;
+}